@@ -0,0 +1,210 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef SCY_Archo_Zip_H
+#define SCY_Archo_Zip_H
+
+
+#include "scy/base64.h"
+#include "scy/types.h"
+#include "scy/buffer.h"
+#include "scy/mutex.h"
+#include "scy/queue.h"
+#include "scy/thread.h"
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <unzip.h> // zlib
+#include <zip.h>
+
+
+namespace scy {
+namespace arc {
+
+	
+struct ZipFile 
+{
+	struct FileInfo
+	{
+		std::string path;
+		size_t      compressedSize;
+		size_t      uncompressedSize;
+		UInt64      offset;		// The entry position for unzSetOffset64()
+		bool        directory;
+	};
+
+	typedef std::function<void(const FileInfo& file, const char* data, std::size_t len)> DataCallback;
+		// Receives the decompressed contents of a file in chunks, 
+		// followed by a call with a zero length when it is complete.
+		// The data is only valid for the duration of the call.
+
+	ZipFile();
+	ZipFile(const std::string& file);
+	~ZipFile();
+
+	void open(const std::string& file);
+	bool opened() const;
+	void close();
+	
+	void extract(const std::string& path, unsigned threads = 0);
+		// Extracts the archive contents to the given directory path.
+		// Files are divided between the given number of worker threads,
+		// largest first, each with its own handle on the archive.
+		// Zero uses a thread per CPU core.
+		// Throws the first error once all the workers have stopped.
+
+	void extract(const DataCallback& callback, unsigned threads = 1);
+		// Streams the contents of each file to the callback rather 
+		// than to disk. With more than one thread the callback is 
+		// called concurrently for different files.
+	
+	bool extractCurrentFile(const std::string& path, bool whiny = true);
+
+	bool goToFirstFile();
+	bool goToNextFile();
+
+	void openCurrentFile();
+	void closeCurrentFile();
+
+	std::string currentFileName();
+
+	std::vector<FileInfo> info;
+	std::string file;
+	unzFile fp;
+};
+
+
+class ZipWriter
+	/// Writes zip archives, compressing entries on a pool of threads.
+	///
+	/// Entries are split into blocks which are deflated in parallel.
+	/// Each block is primed with the end of the block before it, and 
+	/// all but the last are ended with a sync flush, so the blocks join
+	/// into a single deflate stream as they do in pigz. Blocks are written
+	/// to the archive in order as they complete, and only a few blocks 
+	/// per thread are in flight, so memory use stays bounded for entries
+	/// of any size. Entries of 4 GB or more are written as ZIP64.
+{
+public:
+	enum Method
+	{
+		Stored		= 0,			// No compression, for already compressed media
+		Deflated	= Z_DEFLATED
+	};
+
+	ZipWriter(unsigned threads = 0, int level = Z_DEFAULT_COMPRESSION);
+	ZipWriter(const std::string& file, unsigned threads = 0, int level = Z_DEFAULT_COMPRESSION);
+		// Zero threads uses a thread per CPU core.
+
+	~ZipWriter();
+
+	void open(const std::string& file);
+	bool opened() const;
+
+	void close();
+		// Writes the remaining entries and the central directory,
+		// and closes the archive.
+	
+	void addFile(const std::string& path, const std::string& name, Method method = Deflated);
+		// Adds the file at the given path under the given entry name.
+		// The entry may still be compressing when this method returns.
+
+	void addData(const std::string& name, const char* data, std::size_t len, Method method = Deflated);
+		// Adds the data under the given entry name.
+	
+	static const std::size_t BLOCK_SIZE = 128 * 1024;
+	static const std::size_t DICTIONARY_SIZE = 32 * 1024;
+
+	zipFile fp;
+
+protected:
+	struct Entry
+	{
+		std::string name;
+		Method method;
+		UInt64 size;
+		zip_fileinfo info;
+		uLong crc;			// The CRC of the blocks written so far
+	};
+
+	struct Block
+	{
+		std::shared_ptr<Entry> entry;
+		Buffer input;
+		Buffer dictionary;	// The end of the previous block in the entry
+		Buffer output;
+		uLong crc;
+		bool first;
+		bool last;
+		bool done;
+		std::string error;
+	};
+
+	void addBlock(Block* block);
+		// Queues the block for compression, writing completed blocks 
+		// while too many are in flight.
+
+	void writeBlock();
+		// Waits for the oldest block to complete and writes it.
+		// If the block fails the rest of its entry is discarded.
+
+	void discard(const std::shared_ptr<Entry>& entry);
+		// Drops the pending blocks of the given entry once
+		// the workers are done with them.
+
+	void compress(Block& block, z_stream& strm);
+	void work();
+
+	unsigned _threads;
+	int _level;
+	std::deque<Block*> _pending;
+	BlockingQueue<Block*> _jobs;
+	std::vector<Thread::ptr> _workers;
+	Mutex _mutex;
+	Condition _done;
+};
+
+
+#if 0
+class zip_error : public std::runtime_error 
+{
+public:
+	zip_error(const std::string& func) : runtime_error(func) {}
+	zip_error(const std::string& func, int msg) : runtime_error(func + ": " + errmsg(msg)) {}
+	zip_error(const std::string& func, const std::string& msg) : runtime_error(func + ": " + msg) {}
+
+	static std::string errmsg(int e);
+};
+#endif
+	
+
+} } // namespace scy::arc
+
+
+#endif // SCY_Archo_Zip_H
+
+
+
+	
+
+	//typedef std::vector<FileInfo> FileInfoList;
+	//std::vector< ci::fs::path > getFiles();
+	//std::pair<boost::shared_array<char>,size_t> ReadCurrentFile();
+	//private:
\ No newline at end of file
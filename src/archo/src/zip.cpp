@@ -0,0 +1,723 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "scy/archo/zip.h"
+#include "scy/filesystem.h"
+#include "scy/thread.h"
+#include "scy/mutex.h"
+#include "scy/buffer.h"
+
+#include <atomic>
+#include <algorithm>
+#include <thread>
+#include <set>
+#include <cstdio>
+#include <cerrno>
+#include <ctime>
+#include <fstream>
+#include <sys/stat.h>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+using std::endl; 
+
+
+namespace scy {
+namespace arc {
+	
+
+namespace internal {
+
+	std::string errmsg(int code)
+	{
+		switch(code) {
+			case UNZ_END_OF_LIST_OF_FILE:		return "end of file list reached";
+			case UNZ_EOF:						return "end of file reached";
+			case UNZ_PARAMERROR:				return "invalid parameter given";
+			case UNZ_BADZIPFILE:				return "bad zip file";
+			case UNZ_INTERNALERROR:				return "internal error";
+			case UNZ_CRCERROR:					return "crc error, file is corrupt";
+			case UNZ_ERRNO:						return strerror(code);
+			default:							return "unknown error";
+		}
+	}
+
+	void throwError(const std::string& error, int code = 0)
+	{
+		std::string msg;
+		if (!error.empty()) {
+			msg += error;
+		}
+		if (code) {
+			msg += ": ";
+			msg += errmsg(code);
+		}
+		throw std::runtime_error(msg);
+	}
+		
+	void api(const char* what, int ret)
+	{
+		if (ret != UNZ_OK)
+			throwError(what, ret);
+	}
+
+	const std::size_t BUFFER_SIZE = 256 * 1024;
+		// The size of the buffer each file is inflated through
+
+	bool isDirectory(const unz_file_info64& info, const char* fname)
+	{
+#if !WIN32
+		const int FILE_ATTRIBUTE_DIRECTORY = 0x10;
+#endif
+		std::size_t len = strlen(fname);
+		return (info.external_fa & FILE_ATTRIBUTE_DIRECTORY) || 
+			(len > 0 && fname[len - 1] == fs::delimiter);
+	}
+
+	void writeFile(unzFile fp, const std::string& outPath, std::size_t size, Buffer& buffer)
+		// Inflates the current file to the output path. The output
+		// is allocated up front where the platform supports it, so 
+		// the filesystem can lay the file out in contiguous blocks.
+	{
+		FILE* out = fopen(outPath.c_str(), "wb");
+		if (!out)
+			throw std::runtime_error("Cannot open zip output file: " + outPath);
+
+#if defined(__linux__)
+		if (size > 0)
+			posix_fallocate(fileno(out), 0, static_cast<off_t>(size)); // best effort
+#endif
+		int ret;
+		std::size_t written = 0;
+		while ((ret = unzReadCurrentFile(fp, buffer.data(), static_cast<unsigned>(buffer.size()))) > 0) {
+			if (fwrite(buffer.data(), 1, ret, out) != static_cast<std::size_t>(ret)) {
+				fclose(out);
+				throw std::runtime_error("Cannot write zip output file: " + outPath);
+			}
+			written += ret;
+		}
+#if defined(__linux__)
+		if (written < size) {
+			fflush(out);
+			if (ftruncate(fileno(out), static_cast<off_t>(written)) != 0) // drop the unused allocation
+				WarnL << "Cannot truncate zip output file: " << outPath << ": " << strerror(errno) << endl;
+		}
+#endif
+		fclose(out);
+		api("unzReadCurrentFile", ret); // throw file read errors
+	}
+
+	unsigned threadCount(unsigned threads)
+	{
+		return threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	void setTime(zip_fileinfo& info, time_t t)
+	{
+		std::tm* tm = std::localtime(&t);
+		info.tmz_date.tm_sec  = tm->tm_sec;
+		info.tmz_date.tm_min  = tm->tm_min;
+		info.tmz_date.tm_hour = tm->tm_hour;
+		info.tmz_date.tm_mday = tm->tm_mday;
+		info.tmz_date.tm_mon  = tm->tm_mon;
+		info.tmz_date.tm_year = tm->tm_year + 1900;
+		info.dosDate = 0;
+		info.internal_fa = 0;
+		info.external_fa = 0;
+	}
+
+	time_t modifiedTime(const std::string& path)
+	{
+#ifdef WIN32
+		struct _stat s;
+		if (_stat(path.c_str(), &s) == 0)
+#else
+		struct stat s;
+		if (stat(path.c_str(), &s) == 0)
+#endif
+			return s.st_mtime;
+		return time(nullptr);
+	}
+
+	void zapi(const char* what, int ret)
+	{
+		if (ret != ZIP_OK)
+			throwError(util::format("%s failed: %d", what, ret));
+	}
+
+	template <typename Handler>
+	void runWorkers(const ZipFile& zip, unsigned threads, Handler handler)
+		// Runs the handler for each file in the archive on a pool of 
+		// workers, each with its own handle on the archive. Workers 
+		// claim files in turn, largest first, so the pool stays busy
+		// until the end. The first error stops the remaining workers
+		// and is thrown once they have all stopped.
+	{
+		std::vector<const ZipFile::FileInfo*> order;
+		for (auto& entry : zip.info) {
+			if (!entry.directory)
+				order.push_back(&entry);
+		}
+		std::stable_sort(order.begin(), order.end(), 
+			[](const ZipFile::FileInfo* a, const ZipFile::FileInfo* b) {
+				return a->uncompressedSize > b->uncompressedSize; 
+			});
+
+		threads = threadCount(threads);
+		threads = static_cast<unsigned>(std::min<std::size_t>(threads, order.size()));
+
+		std::atomic<std::size_t> next(0);
+		std::atomic<bool> failed(false);
+		std::string error;
+		Mutex mutex;
+		auto work = [&]() {
+			unzFile fp = nullptr;
+			try {
+				fp = unzOpen64(fs::transcode(zip.file).c_str());
+				if (fp == nullptr)
+					throwError("Cannot open archive file: " + zip.file);
+
+				Buffer buffer(BUFFER_SIZE);
+				std::size_t index;
+				while (!failed && (index = next++) < order.size()) {
+					const ZipFile::FileInfo& entry = *order[index];
+					api("unzSetOffset64", unzSetOffset64(fp, entry.offset));
+					api("unzOpenCurrentFile", unzOpenCurrentFile(fp));
+					handler(fp, entry, buffer);
+					api("unzCloseCurrentFile", unzCloseCurrentFile(fp)); // throw CRC errors
+				}
+			}
+			catch (std::exception& exc) {
+				Mutex::ScopedLock lock(mutex);
+				if (!failed) {
+					failed = true;
+					error = exc.what();
+				}
+			}
+			if (fp)
+				unzClose(fp);
+		};
+		
+		if (threads <= 1)
+			work();
+		else {
+			std::vector<Thread::ptr> workers;
+			for (unsigned i = 0; i < threads; i++)
+				workers.push_back(std::make_shared<Thread>(work));
+			for (auto& worker : workers)
+				worker->join();
+		}
+
+		if (failed)
+			throw std::runtime_error(error);
+	}
+
+} // namespace internal
+
+
+ZipFile::ZipFile() : 
+	fp(nullptr) 
+{
+}
+
+
+ZipFile::ZipFile(const std::string& file) : fp(nullptr)
+{
+	this->open(file);
+}
+
+
+ZipFile::~ZipFile()
+{
+	this->close();
+}
+
+
+bool ZipFile::opened() const
+{
+	return this->fp != nullptr;
+}
+
+
+void ZipFile::open(const std::string& file) 
+{
+	this->close();
+	this->fp = unzOpen64(fs::transcode(file).c_str());
+	if (this->fp == nullptr) 
+		internal::throwError("Cannot open archive file: " + file);
+	this->file = file;
+	
+	for (int ret = unzGoToFirstFile(this->fp); ret == UNZ_OK; ret = unzGoToNextFile(this->fp)) {
+		unz_file_info64 fileInfo;
+		char fileName[1024];
+		internal::api("unzGetCurrentFileInfo64", unzGetCurrentFileInfo64(this->fp, &fileInfo, fileName, 1024, nullptr, 0, nullptr, 0));
+
+		FileInfo info;
+		info.path             = fileName;
+		info.compressedSize   = static_cast< size_t >(fileInfo.compressed_size);
+		info.uncompressedSize = static_cast< size_t >(fileInfo.uncompressed_size);
+		info.offset           = unzGetOffset64(this->fp);
+		info.directory        = internal::isDirectory(fileInfo, fileName);
+		this->info.push_back(info);
+
+		TraceL << "Zip file contains: " << fileName << endl;
+	}
+
+	unzGoToFirstFile(this->fp); // rewind
+}
+
+
+void ZipFile::close() 
+{
+	if (this->opened()) {
+		internal::api("unzClose", unzClose(this->fp));
+		this->fp = nullptr;
+	}
+	this->info.clear();
+	this->file.clear();
+}
+
+
+void ZipFile::extract(const std::string& path, unsigned threads)
+{	
+	TraceL << "Extracting zip to: " << path << endl;
+
+	if (!opened())
+		throw std::runtime_error("The archive must be opened for extraction.");
+
+	// Create the directory tree up front so the workers only write files
+	std::set<std::string> dirs;
+	for (auto& entry : this->info) {
+		std::string outPath(path);
+		fs::addnode(outPath, entry.path);
+		std::string dir(entry.directory ? outPath : fs::dirname(outPath));
+		if (dirs.insert(dir).second) {
+			TraceL << "Create directory: " << dir << endl;
+			fs::mkdirr(dir);
+		}
+	}
+
+	internal::runWorkers(*this, threads, 
+		[&](unzFile fp, const FileInfo& entry, Buffer& buffer) {
+			std::string outPath(path);
+			fs::addnode(outPath, entry.path);
+			//TraceL << "Extracting asset: " << outPath << endl;
+			internal::writeFile(fp, outPath, entry.uncompressedSize, buffer);
+		});
+}
+
+
+void ZipFile::extract(const DataCallback& callback, unsigned threads)
+{	
+	if (!opened())
+		throw std::runtime_error("The archive must be opened for extraction.");
+
+	internal::runWorkers(*this, threads, 
+		[&](unzFile fp, const FileInfo& entry, Buffer& buffer) {
+			int ret;
+			while ((ret = unzReadCurrentFile(fp, buffer.data(), static_cast<unsigned>(buffer.size()))) > 0)
+				callback(entry, buffer.data(), ret);
+			internal::api("unzReadCurrentFile", ret); // throw file read errors
+			callback(entry, buffer.data(), 0);
+		});
+}
+
+
+bool ZipFile::extractCurrentFile(const std::string& path, bool whiny)
+{	
+	int ret;
+	unz_file_info info;
+	char fname[1024];
+
+	try {
+		internal::api("unzGetCurrentFileInfo", unzGetCurrentFileInfo(this->fp, &info, fname, 1024, nullptr, 0, nullptr, 0));
+		
+		std::string outPath(path);
+		fs::addnode(outPath, fname);
+
+		TraceL << "Extracting asset: " << outPath << endl;
+
+		// Create directory
+#if !WIN32
+		const int FILE_ATTRIBUTE_DIRECTORY = 0x10;
+#endif
+		if (info.external_fa & FILE_ATTRIBUTE_DIRECTORY || 
+			fname[strlen(fname) - 1] == fs::delimiter) {
+			TraceL << "Create directory: " << outPath << endl;
+			fs::mkdirr(outPath);
+		}
+
+		// Create file
+		else {			
+			TraceL << "Create file: " << outPath << endl;
+
+			// Note: If this fails the file we are trying 
+			// to write may be in use on the filesystem.
+			openCurrentFile();
+
+			std::ofstream ofs(outPath, std::ios::binary | std::ios::out);
+
+			// FIX: FILE_ATTRIBUTE_DIRECTORY can be inconsistent, so we 
+			// need to be ready to create directories if the output file 
+			// fails to open.
+			if (!ofs.is_open()) {
+				fs::mkdirr(fs::dirname(outPath));
+				ofs.open(outPath);
+			}
+
+			if (!ofs.is_open())
+				throw std::runtime_error("Cannot open zip output file: " + outPath);
+			
+			char buffer[16384];
+			while ((ret = unzReadCurrentFile(this->fp, buffer, 16384)) > 0)
+				ofs.write(buffer, ret);
+			
+			ofs.close();
+			
+			internal::api("unzReadCurrentFile", ret); // throw file read errors
+			closeCurrentFile();
+		}
+	} 
+	catch (std::exception& exc) {
+		ErrorL << "Cannot unzip file: " << exc.what() << endl;
+		if (whiny)
+			throw exc;
+		return false;
+	}
+	return true;
+}
+
+
+bool ZipFile::goToFirstFile()
+{
+	return unzGoToFirstFile(this->fp) == UNZ_OK;
+}
+
+
+bool ZipFile::goToNextFile()
+{
+	return unzGoToNextFile(this->fp) == UNZ_OK;
+}
+
+
+void ZipFile::openCurrentFile()
+{	
+	internal::api("unzOpenCurrentFile", unzOpenCurrentFile(this->fp));
+}
+
+
+void ZipFile::closeCurrentFile()
+{
+	internal::api("unzCloseCurrentFile", unzCloseCurrentFile(this->fp));
+}
+
+
+std::string ZipFile::currentFileName()
+{
+	char buf[1024];
+	internal::api("unzGetCurrentFileInfo", 
+		unzGetCurrentFileInfo(this->fp, nullptr, buf, 
+			sizeof(buf), nullptr, 0, nullptr, 0));
+	return buf;
+}
+
+
+//
+// Zip Writer
+//
+
+
+const std::size_t ZipWriter::BLOCK_SIZE;
+const std::size_t ZipWriter::DICTIONARY_SIZE;
+
+
+ZipWriter::ZipWriter(unsigned threads, int level) : 
+	fp(nullptr),
+	_threads(internal::threadCount(threads)),
+	_level(level),
+	_jobs(_threads * 4)
+{
+}
+
+
+ZipWriter::ZipWriter(const std::string& file, unsigned threads, int level) : 
+	fp(nullptr),
+	_threads(internal::threadCount(threads)),
+	_level(level),
+	_jobs(_threads * 4)
+{
+	this->open(file);
+}
+
+
+ZipWriter::~ZipWriter()
+{
+	try {
+		this->close();
+	}
+	catch (std::exception& exc) {
+		ErrorL << "Cannot close zip archive: " << exc.what() << endl;
+	}
+}
+
+
+bool ZipWriter::opened() const
+{
+	return this->fp != nullptr;
+}
+
+
+void ZipWriter::open(const std::string& file) 
+{
+	this->close();
+	this->fp = zipOpen64(fs::transcode(file).c_str(), APPEND_STATUS_CREATE);
+	if (this->fp == nullptr) 
+		internal::throwError("Cannot create archive file: " + file);
+
+	_jobs.reset();
+	for (unsigned i = 0; i < _threads; i++)
+		_workers.push_back(std::make_shared<Thread>(std::bind(&ZipWriter::work, this)));
+}
+
+
+void ZipWriter::close() 
+{
+	if (!this->opened())
+		return;
+
+	// Write the remaining blocks, then stop the workers 
+	std::string error;
+	try {
+		while (!_pending.empty())
+			writeBlock();
+	}
+	catch (std::exception& exc) {
+		error = exc.what();
+	}
+	_jobs.close();
+	for (auto& worker : _workers)
+		worker->join();
+	_workers.clear();
+	for (auto block : _pending)
+		delete block;
+	_pending.clear();
+
+	int ret = zipClose(this->fp, nullptr);
+	this->fp = nullptr;
+	if (!error.empty())
+		throw std::runtime_error(error);
+	internal::zapi("zipClose", ret);
+}
+
+
+void ZipWriter::addFile(const std::string& path, const std::string& name, Method method)
+{
+	if (!opened())
+		throw std::runtime_error("The archive must be opened for writing.");
+
+	std::ifstream ifs(path, std::ios::binary | std::ios::in);
+	if (!ifs.is_open())
+		throw std::runtime_error("Cannot open zip input file: " + path);
+
+	auto entry = std::make_shared<Entry>();
+	entry->name = name;
+	entry->method = method;
+	entry->size = static_cast<UInt64>(std::max<Int64>(fs::filesize(path), 0));
+	entry->crc = crc32(0L, nullptr, 0);
+	internal::setTime(entry->info, internal::modifiedTime(path));
+
+	// Read the file a block at a time, so compression of each 
+	// block overlaps with reading the next
+	UInt64 remaining = entry->size;
+	Buffer dictionary;
+	do {
+		auto block = new Block();
+		block->entry = entry;
+		block->input.resize(static_cast<std::size_t>(std::min<UInt64>(remaining, BLOCK_SIZE)));
+		if (!block->input.empty() && !ifs.read(block->input.data(), block->input.size())) {
+			delete block;
+			throw std::runtime_error("Cannot read zip input file: " + path);
+		}
+		block->first = remaining == entry->size;
+		remaining -= block->input.size();
+		block->last = remaining == 0;
+		if (method == Deflated) {
+			block->dictionary.swap(dictionary);
+			std::size_t len = std::min(block->input.size(), DICTIONARY_SIZE);
+			dictionary.assign(block->input.end() - len, block->input.end());
+		}
+		addBlock(block);
+	} 
+	while (remaining > 0);
+}
+
+
+void ZipWriter::addData(const std::string& name, const char* data, std::size_t len, Method method)
+{
+	if (!opened())
+		throw std::runtime_error("The archive must be opened for writing.");
+
+	auto entry = std::make_shared<Entry>();
+	entry->name = name;
+	entry->method = method;
+	entry->size = len;
+	entry->crc = crc32(0L, nullptr, 0);
+	internal::setTime(entry->info, time(nullptr));
+
+	std::size_t offset = 0;
+	do {
+		std::size_t size = std::min(len - offset, BLOCK_SIZE);
+		auto block = new Block();
+		block->entry = entry;
+		block->input.assign(data + offset, data + offset + size);
+		block->first = offset == 0;
+		block->last = offset + size == len;
+		if (offset > 0 && method == Deflated) {
+			std::size_t dictionary = std::min(offset, DICTIONARY_SIZE);
+			block->dictionary.assign(data + offset - dictionary, data + offset);
+		}
+		addBlock(block);
+		offset += size;
+	} 
+	while (offset < len);
+}
+
+
+void ZipWriter::addBlock(Block* block)
+{
+	block->crc = 0;
+	block->done = false;
+	_pending.push_back(block);
+	_jobs.push(block);
+	while (_pending.size() > _jobs.limit())
+		writeBlock();
+}
+
+
+void ZipWriter::writeBlock()
+{
+	Block* block = _pending.front();
+	{
+		Mutex::ScopedLock lock(_mutex);
+		while (!block->done)
+			_done.wait(_mutex);
+	}
+	_pending.pop_front();
+	std::unique_ptr<Block> deleter(block);
+
+	Entry& entry = *block->entry;
+	try {
+		if (!block->error.empty())
+			throw std::runtime_error(block->error);
+
+		if (block->first) {
+			//TraceL << "Writing entry: " << entry.name << endl;
+			internal::zapi("zipOpenNewFileInZip2_64", zipOpenNewFileInZip2_64(this->fp, entry.name.c_str(), 
+				&entry.info, nullptr, 0, nullptr, 0, nullptr, entry.method, _level, 1, 
+				entry.size >= 0xffffffff ? 1 : 0));
+		}
+
+		const Buffer& data = entry.method == Deflated ? block->output : block->input;
+		if (!data.empty())
+			internal::zapi("zipWriteInFileInZip", zipWriteInFileInZip(this->fp, data.data(), static_cast<unsigned>(data.size())));
+		entry.crc = crc32_combine(entry.crc, block->crc, static_cast<z_off_t>(block->input.size()));
+
+		if (block->last)
+			internal::zapi("zipCloseFileInZipRaw64", zipCloseFileInZipRaw64(this->fp, entry.size, entry.crc));
+	}
+	catch (std::exception&) {
+		// The rest of the entry can't follow a missing block
+		discard(block->entry);
+		throw;
+	}
+}
+
+
+void ZipWriter::discard(const std::shared_ptr<Entry>& entry)
+{
+	while (!_pending.empty() && _pending.front()->entry == entry) {
+		Block* block = _pending.front();
+		{
+			Mutex::ScopedLock lock(_mutex);
+			while (!block->done)
+				_done.wait(_mutex);
+		}
+		_pending.pop_front();
+		delete block;
+	}
+}
+
+
+void ZipWriter::compress(Block& block, z_stream& strm)
+{
+	block.crc = crc32(0L, reinterpret_cast<const Bytef*>(block.input.data()), static_cast<uInt>(block.input.size()));
+	if (block.entry->method != Deflated)
+		return;
+
+	// Raw deflate each block with the end of the previous block as the 
+	// dictionary. A sync flush ends all but the last block on a byte 
+	// boundary so the blocks can be concatenated.
+	internal::zapi("deflateReset", deflateReset(&strm));
+	if (!block.dictionary.empty())
+		internal::zapi("deflateSetDictionary", deflateSetDictionary(&strm, 
+			reinterpret_cast<const Bytef*>(block.dictionary.data()), static_cast<uInt>(block.dictionary.size())));
+
+	block.output.resize(deflateBound(&strm, static_cast<uLong>(block.input.size())) + 16);
+	strm.next_in = reinterpret_cast<Bytef*>(block.input.data());
+	strm.avail_in = static_cast<uInt>(block.input.size());
+	strm.next_out = reinterpret_cast<Bytef*>(block.output.data());
+	strm.avail_out = static_cast<uInt>(block.output.size());
+	int ret = deflate(&strm, block.last ? Z_FINISH : Z_SYNC_FLUSH);
+	if (ret != (block.last ? Z_STREAM_END : Z_OK) || strm.avail_in != 0)
+		internal::throwError(util::format("deflate failed: %d", ret));
+	block.output.resize(block.output.size() - strm.avail_out);
+}
+
+
+void ZipWriter::work()
+{
+	z_stream strm;
+	memset(&strm, 0, sizeof(strm));
+	bool ok = deflateInit2(&strm, _level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+
+	Block* block;
+	while (_jobs.pop(block)) {
+		try {
+			if (!ok)
+				throw std::runtime_error("deflateInit2 failed");
+			compress(*block, strm);
+		}
+		catch (std::exception& exc) {
+			block->error = exc.what();
+		}
+		Mutex::ScopedLock lock(_mutex);
+		block->done = true;
+		_done.broadcast();
+	}
+
+	if (ok)
+		deflateEnd(&strm);
+}
+
+
+} } // namespace scy::arc
@@ -0,0 +1,370 @@
+#include "scy/base.h"
+#include "scy/platform.h"
+#include "scy/filesystem.h"
+#include "scy/logger.h"
+#include "scy/util.h"
+#include "scy/archo/zip.h"
+#include "scy/uv/uvpp.h"
+#include <zip.h> // minizip
+
+#include <assert.h>
+#include <algorithm>
+#include <stdexcept>
+#include <atomic>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <set>
+
+
+using namespace std;
+using namespace scy;
+
+
+/*
+// Detect Memory Leaks
+#ifdef _DEBUG
+#include "MemLeakDetect/MemLeakDetect.cpp"
+#include "MemLeakDetect/MemLeakDetect.h"
+CMemLeakDetect memLeakDetect;
+#endif
+*/
+
+
+namespace scy {
+namespace arc {
+	
+
+class Tests
+{
+public:
+	Tests()
+	{					
+		testUnzip();
+		testZipWriter();
+		testExtract();
+#if 0
+		benchmarkExtract();
+		benchmarkCompress();
+#endif
+	}
+	
+	void testUnzip() 
+	{			
+		std::string path("recordingmodeplugin-0.9.2-sdk-0.6.0-win32-debug.zip");
+		ZipFile zip(path);	
+		
+		std::string output(scy::getCwd());
+		fs::addnode(output, "test");
+		zip.extract(output);
+	}	
+
+	static std::string createData(std::size_t size, UInt32 seed)
+		// Returns compressible pseudo-random data.
+	{
+		std::string data(size, ' ');
+		for (std::size_t i = 0; i < size; i++) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = "abcdefgh 01234567\n"[(seed >> 16) % 18];
+		}
+		return data;
+	}
+
+	static std::map<std::string, std::string> readArchive(const std::string& path, unsigned threads)
+		// Extracts the archive through the callback, checking that
+		// each file ends with a single zero length call.
+	{
+		std::map<std::string, std::string> files;
+		std::set<std::string> ended;
+		Mutex mutex;
+		ZipFile zip(path);
+		zip.extract([&](const ZipFile::FileInfo& file, const char* data, std::size_t len) {
+			Mutex::ScopedLock lock(mutex);
+			assert(!ended.count(file.path));
+			if (len == 0)
+				ended.insert(file.path);
+			files[file.path].append(data, len);
+		}, threads);
+		assert(ended.size() == files.size());
+		return files;
+	}
+
+	void testZipWriter()
+	{
+		const std::size_t B = ZipWriter::BLOCK_SIZE;
+		std::map<std::string, std::pair<std::string, ZipWriter::Method>> entries;
+		entries["deflated/multi.dat"] = std::make_pair(createData(3 * B + 1234, 1), ZipWriter::Deflated);
+		entries["deflated/exact.dat"] = std::make_pair(createData(2 * B, 2), ZipWriter::Deflated);
+		entries["deflated/small.dat"] = std::make_pair(createData(100, 3), ZipWriter::Deflated);
+		entries["deflated/empty.dat"] = std::make_pair(std::string(), ZipWriter::Deflated);
+		entries["stored/multi.dat"] = std::make_pair(createData(B + 100, 4), ZipWriter::Stored);
+		entries["stored/empty.dat"] = std::make_pair(std::string(), ZipWriter::Stored);
+
+		// Input files for addFile
+		std::string input(createData(2 * B + 77, 5));
+		{
+			std::ofstream ofs("zipwriter-input.dat", std::ios::binary | std::ios::out);
+			ofs.write(input.data(), input.size());
+		}
+		std::string emptyInput("zipwriter-empty.dat");
+		std::ofstream(emptyInput, std::ios::binary | std::ios::out).close();
+
+		unsigned threads[] = { 1, 3 };
+		for (unsigned t : threads) {
+			std::string path("zipwriter.zip");
+			{
+				ZipWriter writer(path, t);
+				for (auto& kv : entries)
+					writer.addData(kv.first, kv.second.first.data(), kv.second.first.size(), kv.second.second);
+				writer.addFile("zipwriter-input.dat", "file/deflated.dat");
+				writer.addFile("zipwriter-input.dat", "file/stored.dat", ZipWriter::Stored);
+				writer.addFile(emptyInput, "file/empty.dat");
+				writer.close();
+			}
+
+			// Reading back checks the CRC of each entry
+			auto files = readArchive(path, t);
+			assert(files.size() == entries.size() + 3);
+			for (auto& kv : entries)
+				assert(files[kv.first] == kv.second.first);
+			assert(files["file/deflated.dat"] == input);
+			assert(files["file/stored.dat"] == input);
+			assert(files["file/empty.dat"].empty());
+
+			// Stored entries are written as is
+			ZipFile zip(path);
+			for (auto& file : zip.info) {
+				if (file.path.find("stored/") == 0 || file.path == "file/stored.dat")
+					assert(file.compressedSize == file.uncompressedSize);
+				else if (file.uncompressedSize > B)
+					assert(file.compressedSize < file.uncompressedSize);
+			}
+		}
+	}
+
+	void testExtract()
+	{
+		// Files in nested directories, with explicit directory 
+		// entries for some and an empty file
+		std::map<std::string, std::string> files;
+		files["root.txt"] = createData(1000, 1);
+		files["docs/readme.txt"] = createData(50 * 1024, 2);
+		files["docs/nested/deep/large.dat"] = createData(600 * 1024, 3);
+		files["docs/nested/deep/empty.dat"] = std::string();
+		files["media/a/b/c/clip.dat"] = createData(300 * 1024, 4);
+		const char* dirs[] = { "docs/", "docs/nested/", "docs/nested/deep/", "media/a/b/c/" };
+
+		std::string path("extract.zip");
+		{
+			zipFile zf = zipOpen64(path.c_str(), 0);
+			assert(zf);
+			zip_fileinfo info = {};
+			for (auto dir : dirs) {
+				zipOpenNewFileInZip64(zf, dir, &info, nullptr, 0, nullptr, 0, nullptr, 0, 0, 0);
+				zipCloseFileInZip(zf);
+			}
+			for (auto& kv : files) {
+				zipOpenNewFileInZip64(zf, kv.first.c_str(), &info, nullptr, 0, nullptr, 0, nullptr, 
+					Z_DEFLATED, Z_DEFAULT_COMPRESSION, 0);
+				zipWriteInFileInZip(zf, kv.second.data(), static_cast<unsigned>(kv.second.size()));
+				zipCloseFileInZip(zf);
+			}
+			zipClose(zf, nullptr);
+		}
+
+		ZipFile zip(path);
+		assert(zip.info.size() == files.size() + 4);
+
+		unsigned threads[] = { 1, 3 };
+		for (unsigned t : threads) {
+
+			// Directory entries are skipped by the callback
+			auto extracted = readArchive(path, t);
+			assert(extracted == files);
+
+			// Extract to an absolute path that doesn't exist yet, 
+			// so the output tree is created from the root
+			std::string output(scy::getCwd());
+			fs::addnode(output, util::format("extract-%u", t));
+			assert(!fs::exists(output));
+			zip.extract(output, t);
+
+			for (auto& kv : files) {
+				std::string file(output);
+				fs::addnode(file, kv.first);
+				std::ifstream ifs(file, std::ios::binary | std::ios::in);
+				assert(ifs.is_open());
+				std::string data((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+				assert(data == kv.second);
+				ifs.close();
+				fs::unlink(file);
+			}
+			const char* tree[] = { "docs/nested/deep", "docs/nested", "docs", 
+				"media/a/b/c", "media/a/b", "media/a", "media", "" };
+			for (auto dir : tree) {
+				std::string node(output);
+				fs::addnode(node, dir);
+				assert(fs::isdir(node));
+				fs::rmdir(node);
+			}
+		}
+	}
+
+	void createArchive(const std::string& path, int numFiles, int fileSize)
+		// Writes an archive of compressible files for benchmarking.
+	{
+		zipFile zf = zipOpen64(path.c_str(), 0);
+		assert(zf);
+		std::string data(fileSize, ' ');
+		UInt32 seed = 1;
+		for (int i = 0; i < numFiles; i++) {
+			for (int j = 0; j < fileSize; j++) {
+				seed = seed * 1103515245 + 12345;
+				data[j] = "abcdefgh 01234567\n"[(seed >> 16) % 18];
+			}
+			std::string name(util::format("assets/%03d/asset%05d.dat", i % 32, i));
+			zip_fileinfo info = {};
+			zipOpenNewFileInZip64(zf, name.c_str(), &info, nullptr, 0, nullptr, 0, nullptr, 
+				Z_DEFLATED, Z_DEFAULT_COMPRESSION, 0);
+			zipWriteInFileInZip(zf, data.data(), static_cast<unsigned>(data.size()));
+			zipCloseFileInZip(zf);
+		}
+		zipClose(zf, nullptr);
+	}
+
+	void benchmarkExtract()
+	{
+		const int numFiles = 2000;
+		const int fileSize = 256 * 1024;
+		std::string path("benchmark.zip");
+		createArchive(path, numFiles, fileSize);
+
+		ZipFile zip(path);
+		double megabytes = double(numFiles) * fileSize / (1024 * 1024);
+		unsigned threads[] = { 1, 2, 4, 0 };
+		for (unsigned t : threads) {
+			std::string output(scy::getCwd());
+			fs::addnode(output, "benchmark");
+			UInt64 start = uv_hrtime();
+			zip.extract(output, t);
+			double secs = (uv_hrtime() - start) / 1e9;
+			cout << "Extract to disk with " << t << " threads: " << (megabytes / secs) << " MB/s" << endl;
+		}
+
+		for (unsigned t : threads) {
+			std::atomic<UInt64> total(0);
+			UInt64 start = uv_hrtime();
+			zip.extract([&](const ZipFile::FileInfo&, const char*, std::size_t len) {
+				total += len;
+			}, t);
+			double secs = (uv_hrtime() - start) / 1e9;
+			assert(total == UInt64(numFiles) * fileSize);
+			cout << "Extract to callback with " << t << " threads: " << (megabytes / secs) << " MB/s" << endl;
+		}
+	}
+
+	void benchmarkCompress()
+	{
+		const int numFiles = 64;
+		const int fileSize = 4 * 1024 * 1024;
+		std::string data(fileSize, ' ');
+		UInt32 seed = 1;
+		for (int j = 0; j < fileSize; j++) {
+			seed = seed * 1103515245 + 12345;
+			data[j] = "abcdefgh 01234567\n"[(seed >> 16) % 18];
+		}
+
+		double megabytes = double(numFiles) * fileSize / (1024 * 1024);
+		unsigned threads[] = { 1, 2, 4, 0 };
+		for (unsigned t : threads) {
+			for (int stored = 0; stored < 2; stored++) {
+				UInt64 start = uv_hrtime();
+				{
+					ZipWriter writer("compress.zip", t);
+					for (int i = 0; i < numFiles; i++) {
+						writer.addData(util::format("session/segment%03d.dat", i), data.data(), data.size(), 
+							stored ? ZipWriter::Stored : ZipWriter::Deflated);
+					}
+					writer.close();
+				}
+				double secs = (uv_hrtime() - start) / 1e9;
+				cout << "Compress " << (stored ? "stored" : "deflated") << " with " << t << " threads: " 
+					<< (megabytes / secs) << " MB/s" << endl;
+
+				// Read the archive back, which checks the CRC of each entry
+				ZipFile zip("compress.zip");
+				assert(zip.info.size() == numFiles);
+				std::atomic<UInt64> total(0);
+				zip.extract([&](const ZipFile::FileInfo&, const char*, std::size_t len) {
+					total += len;
+				});
+				assert(total == UInt64(numFiles) * fileSize);
+			}
+		}
+	}
+	
+	
+	/*
+	void testGZStream()
+	{	
+
+		std::string path("gzstream.tgz");
+		std::string dest("gzstream");
+
+		assert(fs::exists("gzstream.tgz"));
+
+		// check alternate way of opening file
+		igzstream in2;
+		in2.open(path.c_str());
+		if (!in2.good()) {
+			std::cerr << "ERROR: Opening file `" << path << "' failed.\n";
+			assert(0);
+		}
+		in2.close();
+		if (!in2.good()) {
+			std::cerr << "ERROR: Closing file `" << path << "' failed.\n";
+			assert(0);
+		}
+
+		// now use the shorter way with the constructor to open the same file
+		igzstream in(path.c_str());
+		if (!in.good()) {
+			std::cerr << "ERROR: Opening file `" << path << "' failed.\n";
+			assert(0);
+		}
+		std::ofstream out(dest.c_str());
+		if (!out.good()) {
+			std::cerr << "ERROR: Opening file `" << dest << "' failed.\n";
+			assert(0);
+		}
+
+		char c;
+		while (in.get(c))
+			out << c;
+		in.close();
+		out.close();
+		if (!in.eof()) {
+			std::cerr << "ERROR: Reading file `" << path << "' failed.\n";
+			assert(0);
+		}
+		if (!out.good()) {
+			std::cerr << "ERROR: Writing file `" << dest << "' failed.\n";
+			assert(0);
+		}
+	}
+	*/
+};
+
+
+} } // namespace scy::arc
+
+
+int main(int argc, char** argv) 
+{	
+	Logger::instance().add(new ConsoleChannel("Test", LTrace));
+	{
+		arc::Tests app;
+	}	
+	Logger::destroy();
+	return 0;
+}
\ No newline at end of file
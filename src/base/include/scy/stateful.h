@@ -0,0 +1,239 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef SCY_Stateful_H
+#define SCY_Stateful_H
+
+
+#include "scy/signal.h"
+
+#include <atomic>
+#include <string>
+#include <iostream>
+
+
+namespace scy {
+	
+
+class State 
+	/// The state ID is stored atomically so that it can be read
+	/// from any thread without locking. The message is slow path
+	/// data which is only touched on state transitions.
+{ 
+public:
+	typedef unsigned int ID;
+	
+	State(ID id = 0, const std::string& message = "");
+	State(const State& r);
+	virtual ~State() {};
+
+	State& operator = (const State& r);
+
+	ID id() const { return _id.load(std::memory_order_acquire); }
+		// Returns the current state ID. Lock free.
+
+	virtual void set(ID id);
+	
+	bool transition(ID expected, ID desired);
+		// Atomically changes the state ID from expected to desired.
+		// Returns false if the state was changed by another thread.
+
+	virtual std::string message() const;
+	virtual void setMessage(const std::string& message);
+	
+	virtual std::string str(ID id) const;
+	virtual std::string toString() const;
+
+	virtual bool between(ID lid, ID rid) const
+	{ 	
+		ID id = this->id();
+		return id >= lid 
+			&& id <= rid;
+	}
+		
+	virtual bool equals(ID id) const
+	{ 	
+		return this->id() == id;
+	}
+
+	bool operator == (const State& r) 
+	{ 
+		return id() == r.id();
+	}
+
+	bool operator == (const State::ID& r) 
+	{ 
+		return id() == r;
+	}	
+	
+    friend std::ostream& operator << (std::ostream& os, const State& state) 
+	{
+		os << state.toString();
+		return os;
+    }
+
+protected:
+	std::atomic<ID> _id;
+	std::string _message;
+};
+
+
+//
+// Mutex State
+//
+
+
+class MutexState: public State
+	/// The state ID is atomic, so only the message is guarded.
+{ 
+public:
+	MutexState(ID id = 0);
+	MutexState(const MutexState& r) : State(r) {}
+	virtual ~MutexState() {};
+
+	MutexState& operator = (const MutexState& r) { State::operator = (r); return *this; }
+
+	virtual std::string message() const { Mutex::ScopedLock lock(_mutex); return _message; }
+	virtual void setMessage(const std::string& message) { Mutex::ScopedLock lock(_mutex); _message = message; }
+
+protected:
+	mutable Mutex _mutex;
+};
+
+
+//
+// State Signal
+//
+
+
+class StateSignal: public MutexState
+{ 
+public:
+	StateSignal(ID id = 0);
+	StateSignal(const StateSignal& r);
+	virtual ~StateSignal() {};
+		
+	virtual bool change(ID id);
+	virtual bool canChange(ID id);	
+	virtual void onChange(ID id, ID prev);
+	
+	//Signal2<const ID&, const ID&> Change;
+		// Fired when the state changes to signal 
+		// the new and previous states.
+
+protected:	
+	virtual void set(ID id);
+};
+
+
+//
+// Stateful Interface
+//
+
+
+template<typename T>
+class Stateful
+	/// This class implements a simple state machine.
+	/// T should be a derived State type.
+{
+public:	
+	Stateful()
+	{ 	
+	}
+	
+	virtual ~Stateful()
+	{ 	
+	}
+	
+	Signal2<T&, const T&> StateChange;
+		// Fires when the state changes.
+	
+	virtual bool stateEquals(unsigned int id) const
+	{ 	
+		return _state.id() == id;
+	}
+
+	virtual bool stateBetween(unsigned int lid, unsigned int rid) const
+	{ 	
+		unsigned int id = _state.id();
+		return id >= lid 
+			&& id <= rid;
+	}
+
+	virtual T& state() { return _state; }
+	virtual const T state() const { return _state; }
+
+protected:
+	virtual bool beforeStateChange(const T& state) 
+		// Override to handle pre state change logic.
+		// Return false to prevent state change.
+	{
+		if (_state == state) 
+			return false;
+		return true;
+	}
+	
+	virtual void onStateChange(T& /*state*/, const T& /*oldState*/) 
+		// Override to handle post state change logic.
+	{
+	}	
+	
+	virtual bool setState(void* sender, unsigned int id, const std::string& message = "") 
+		// Sets the state and sends the state signal if
+		// the state change was successful.
+	{ 
+		T state;
+		state.set(id);	
+		state.setMessage(message);
+		return setState(sender, state);
+	}
+
+	virtual bool setState(void* sender, const T& state) 
+		// Sets the state and sends the state signal if
+		// the state change was successful.
+		// The state ID is swapped with a CAS, so if a competing
+		// thread changes the state first this call fails.
+	{ 
+		T oldState = _state;
+		if (beforeStateChange(state)) {
+			if (!_state.transition(oldState.id(), state.id()))
+				return false;
+			_state.setMessage(state.message());
+			onStateChange(_state, oldState);
+			if (sender)
+				StateChange.emit(sender, _state, oldState); //self(), 
+			return true;
+		}
+		return false;
+	}
+
+	virtual void setStateMessage(const std::string& message) 
+	{ 
+		_state.setMessage(message);	
+	}
+
+protected:
+	T _state;
+};
+
+
+} // namespace scy
+
+
+#endif // SCY_Stateful_H
\ No newline at end of file
@@ -0,0 +1,147 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#ifndef SCY_TimerWheel_H
+#define SCY_TimerWheel_H
+
+
+#include "scy/timer.h"
+#include "scy/types.h"
+
+#include <functional>
+
+
+namespace scy {
+
+
+class TimerWheel
+	/// A hierarchical timing wheel for managing large numbers of 
+	/// timeouts with a single libuv timer.
+	///
+	/// Scheduling and cancelling are O(1). Each tick only visits the
+	/// entries which are due, plus an occasional cascade of entries
+	/// from a coarser level into a finer one. Deadlines are rounded 
+	/// up to the wheel resolution and measured against the loop time.
+	///
+	/// Entries are owned by the caller and unlinked from the wheel
+	/// when destroyed, so an entry's owner may safely delete itself
+	/// from within the entry callback.
+{
+public:
+	class Entry
+		/// A schedulable timeout. The callback is invoked once
+		/// each time the entry expires.
+	{
+	public:
+		Entry();
+		Entry(const std::function<void()>& callback);
+		~Entry();
+	
+		bool scheduled() const { return _wheel != nullptr; }
+			// Returns true if the entry is waiting to expire.
+
+		void cancel();
+			// Removes the entry from its wheel, if any.
+
+		std::function<void()> callback;
+
+	private:
+		Entry(const Entry&); // = delete;
+		Entry& operator=(const Entry&); // = delete;
+
+		friend class TimerWheel;
+		TimerWheel* _wheel;
+		Entry* _prev;
+		Entry* _next;
+		UInt64 _expires;  // The tick the entry is slotted for
+		UInt64 _deadline; // The tick the entry is due
+	};
+
+	TimerWheel(Int64 resolution = 100, uv::Loop* loop = uv::defaultLoop());
+		// Creates a wheel which ticks every resolution milliseconds.
+	
+	~TimerWheel();
+		// Unlinks all scheduled entries without invoking them.
+
+	void schedule(Entry& entry, Int64 timeout);
+		// Schedules the entry to expire after timeout milliseconds,
+		// rescheduling it if it is already scheduled.
+
+	void cancel(Entry& entry);
+		// Removes the entry from the wheel.
+
+	std::size_t size() const;
+		// Returns the number of scheduled entries.
+
+	Int64 resolution() const;
+		// Returns the tick duration in milliseconds.
+
+	uv::Loop* loop() const;
+	
+	static TimerWheel& shared(uv::Loop* loop = uv::defaultLoop());
+		// Returns the wheel shared by all timeouts on the given 
+		// loop, creating it on first use. The shared wheel ticks
+		// every SharedResolution milliseconds and must only be
+		// used from the loop thread. Application::finalize()
+		// destroys it, and wheels which are never destroyed are 
+		// leaked at exit rather than closed on a dead loop.
+
+	static void destroyShared(uv::Loop* loop = uv::defaultLoop());
+		// Destroys the shared wheel for the given loop. Any entries
+		// still scheduled on it are unlinked without being invoked.
+		// This method must be called from the loop thread before
+		// the loop is closed.
+	
+	enum { SharedResolution = 10 };
+
+protected:
+	enum 
+	{
+		SlotBits = 6,
+		NumSlots = 1 << SlotBits,
+		SlotMask = NumSlots - 1,
+		NumLevels = 4
+	};
+
+	UInt64 currentTick() const;
+	void insert(Entry& entry);
+	void unlink(Entry& entry);
+	void cascade(int level);
+	void expire(UInt64 tick);
+	void onTimer(void*);
+
+	uv::Loop* _loop;
+	Int64 _resolution;
+	UInt64 _epoch;
+	UInt64 _tick;
+	std::size_t _size;
+	Entry* _slots[NumLevels][NumSlots];
+	Timer _timer;
+
+private:
+	TimerWheel(const TimerWheel&); // = delete;
+	TimerWheel& operator=(const TimerWheel&); // = delete;
+};
+
+
+} // namespace scy
+
+
+#endif // SCY_TimerWheel_H
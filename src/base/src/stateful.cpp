@@ -0,0 +1,147 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "scy/stateful.h"
+
+
+using std::endl;
+
+
+namespace scy {
+
+
+State::State(State::ID id, const std::string& message) : 
+	_id(id), _message(message)
+{ 
+}
+
+
+State::State(const State& r) : 
+	_id(r.id()), _message(r.message())
+{ 
+}
+
+
+State& State::operator = (const State& r) 
+{ 
+	if (this != &r) {
+		set(r.id());
+		setMessage(r.message());
+	}
+	return *this;
+}
+
+
+void State::set(State::ID id) 
+{ 
+	_id.store(id, std::memory_order_release); 
+}
+
+
+bool State::transition(State::ID expected, State::ID desired) 
+{ 
+	return _id.compare_exchange_strong(expected, desired, 
+		std::memory_order_acq_rel, std::memory_order_acquire); 
+}
+
+
+std::string State::message() const 
+{ 
+	return _message;
+}
+
+
+void State::setMessage(const std::string& message) 
+{
+	_message = message; 
+}
+	
+
+std::string State::str(State::ID id) const 
+{ 
+	// Must be overridden...
+	(void)id; 
+	return "undefined"; 
+}
+
+
+std::string State::toString() const 
+{ 
+	return str(id()); 
+}
+
+
+//
+// Mutex State
+//
+
+
+MutexState::MutexState(State::ID id) : 
+	State(id)
+{ 
+}
+
+
+//
+// State Signal
+//
+
+
+StateSignal::StateSignal(State::ID id) : 
+	MutexState(id)
+{ 
+}
+
+
+bool StateSignal::change(State::ID id) 
+{ 
+	if (canChange(id)) {
+		unsigned int old = this->id();
+		if (!transition(old, id))
+			return false;
+		onChange(id, old);
+		return true;
+	}
+	return false;
+}
+
+	
+bool StateSignal::canChange(State::ID id) 
+{
+	// Can be overridden
+	if (this->id() != id) 
+		return true;
+	return false;
+}
+
+
+void StateSignal::onChange(ID id, ID prev) 
+{
+	// Can be overridden
+	//Change.emit(this, id, prev);
+}
+
+
+void StateSignal::set(State::ID id) 
+{ 
+	MutexState::set(id); 
+}
+
+
+} // namespace scy
\ No newline at end of file
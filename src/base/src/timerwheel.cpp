@@ -0,0 +1,302 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#include "scy/timerwheel.h"
+#include "scy/logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+
+namespace scy {
+
+
+namespace internal {
+
+	struct SharedWheels
+	{
+		Mutex mutex;
+		std::map<uv::Loop*, TimerWheel*> wheels;
+
+		~SharedWheels() 
+		{
+			// Wheels own uv timer handles which cannot be closed once
+			// the loop is gone, so any left over are leaked. Call
+			// TimerWheel::destroyShared() before closing the loop.
+			if (!wheels.empty())
+				WarnL << "Leaking " << wheels.size() << " shared timer wheel(s)" << std::endl;
+		}
+	};
+
+	static SharedWheels& sharedWheels()
+	{
+		static SharedWheels instance;
+		return instance;
+	}
+
+} // namespace internal
+
+
+TimerWheel::Entry::Entry() :
+	_wheel(nullptr),
+	_prev(nullptr),
+	_next(nullptr),
+	_expires(0),
+	_deadline(0)
+{
+}
+
+
+TimerWheel::Entry::Entry(const std::function<void()>& callback) :
+	callback(callback),
+	_wheel(nullptr),
+	_prev(nullptr),
+	_next(nullptr),
+	_expires(0),
+	_deadline(0)
+{
+}
+
+
+TimerWheel::Entry::~Entry()
+{
+	cancel();
+}
+
+
+void TimerWheel::Entry::cancel()
+{
+	if (_wheel)
+		_wheel->cancel(*this);
+}
+
+
+TimerWheel::TimerWheel(Int64 resolution, uv::Loop* loop) :
+	_loop(loop),
+	_resolution(resolution > 0 ? resolution : 1),
+	_epoch(uv_now(loop)),
+	_tick(0),
+	_size(0),
+	_timer(loop)
+{
+	std::memset(_slots, 0, sizeof(_slots));
+	_timer.Timeout += sdelegate(this, &TimerWheel::onTimer);
+}
+
+
+TimerWheel::~TimerWheel()
+{
+	_timer.Timeout -= sdelegate(this, &TimerWheel::onTimer);
+	_timer.stop();
+	for (int level = 0; level < NumLevels; level++) {
+		for (int slot = 0; slot < NumSlots; slot++) {
+			while (_slots[level][slot])
+				unlink(*_slots[level][slot]);
+		}
+	}
+}
+
+
+void TimerWheel::schedule(Entry& entry, Int64 timeout)
+{
+	if (entry._wheel)
+		entry._wheel->cancel(entry);
+
+	// Nothing is slotted while the wheel is idle, so it can skip 
+	// straight to the present instead of replaying idle ticks.
+	// The tick never moves back, so an entry rescheduled from a 
+	// callback after the wheel empties counts from the current tick.
+	UInt64 now = currentTick();
+	if (_size == 0 && now > _tick)
+		_tick = now;
+
+	// Round up so entries never expire early, and expire no 
+	// sooner than the next tick so expire() always terminates
+	UInt64 ticks = timeout > 0 ? (timeout + _resolution - 1) / _resolution : 0;
+	entry._deadline = std::max<UInt64>(now, _tick) + std::max<UInt64>(ticks, 1);
+	entry._wheel = this;
+	insert(entry);
+	
+	if (++_size == 1)
+		_timer.start(_resolution, _resolution);
+}
+
+
+void TimerWheel::cancel(Entry& entry)
+{
+	if (entry._wheel != this)
+		return;
+	
+	unlink(entry);
+	if (--_size == 0)
+		_timer.stop();
+}
+
+
+void TimerWheel::insert(Entry& entry)
+{
+	// Place the entry in the finest level whose span covers the
+	// deadline. Deadlines beyond the coarsest level are slotted at 
+	// its limit and reinserted when they get there.
+	UInt64 delta = entry._deadline - _tick;
+	int level = 0;
+	while (level < NumLevels - 1 && delta >= (UInt64(1) << (SlotBits * (level + 1))))
+		level++;
+	
+	UInt64 span = UInt64(1) << (SlotBits * NumLevels);
+	entry._expires = delta < span ? entry._deadline : _tick + span - 1;
+
+	Entry*& head = _slots[level][(entry._expires >> (SlotBits * level)) & SlotMask];
+	entry._prev = nullptr;
+	entry._next = head;
+	if (head)
+		head->_prev = &entry;
+	head = &entry;
+}
+
+
+void TimerWheel::unlink(Entry& entry)
+{
+	if (entry._prev)
+		entry._prev->_next = entry._next;
+	else {
+		// The entry is a slot head; find which one
+		for (int level = 0; level < NumLevels; level++) {
+			Entry*& head = _slots[level][(entry._expires >> (SlotBits * level)) & SlotMask];
+			if (head == &entry) {
+				head = entry._next;
+				break;
+			}
+		}
+	}
+	if (entry._next)
+		entry._next->_prev = entry._prev;
+
+	entry._prev = nullptr;
+	entry._next = nullptr;
+	entry._wheel = nullptr;
+}
+
+
+void TimerWheel::cascade(int level)
+{
+	// Move the slot for the current tick down to the finer levels
+	Entry*& head = _slots[level][(_tick >> (SlotBits * level)) & SlotMask];
+	Entry* entry = head;
+	head = nullptr;
+	while (entry) {
+		Entry* next = entry->_next;
+		insert(*entry);
+		entry = next;
+	}
+}
+
+
+void TimerWheel::expire(UInt64 tick)
+{
+	_tick = tick;
+	for (int level = 1; level < NumLevels; level++) {
+		if (_tick & ((UInt64(1) << (SlotBits * level)) - 1))
+			break;
+		cascade(level);
+	}
+
+	// Callbacks may schedule or cancel any entry, including others
+	// in this slot, so take one entry at a time from the head
+	Entry*& head = _slots[0][_tick & SlotMask];
+	while (head) {
+		Entry* entry = head;
+		if (entry->_deadline > _tick) {
+			// A far deadline which was clamped to the coarsest level
+			unlink(*entry);
+			entry->_wheel = this;
+			insert(*entry);
+			continue;
+		}
+		cancel(*entry);
+		if (entry->callback)
+			entry->callback();
+	}
+}
+
+
+void TimerWheel::onTimer(void*)
+{
+	UInt64 now = currentTick();
+	while (_size > 0 && _tick < now)
+		expire(_tick + 1);
+	if (_size == 0)
+		_tick = now;
+}
+
+
+UInt64 TimerWheel::currentTick() const
+{
+	return (uv_now(_loop) - _epoch) / _resolution;
+}
+
+
+std::size_t TimerWheel::size() const
+{
+	return _size;
+}
+
+
+Int64 TimerWheel::resolution() const
+{
+	return _resolution;
+}
+
+
+uv::Loop* TimerWheel::loop() const
+{
+	return _loop;
+}
+
+
+TimerWheel& TimerWheel::shared(uv::Loop* loop)
+{
+	auto& shared = internal::sharedWheels();
+	Mutex::ScopedLock lock(shared.mutex);
+	auto& wheel = shared.wheels[loop];
+	if (!wheel)
+		wheel = new TimerWheel(SharedResolution, loop);
+	return *wheel;
+}
+
+
+void TimerWheel::destroyShared(uv::Loop* loop)
+{
+	TimerWheel* wheel = nullptr;
+	{
+		auto& shared = internal::sharedWheels();
+		Mutex::ScopedLock lock(shared.mutex);
+		auto it = shared.wheels.find(loop);
+		if (it == shared.wheels.end())
+			return;
+		wheel = it->second;
+		shared.wheels.erase(it);
+	}
+	delete wheel;
+}
+
+
+} // namespace scy
@@ -0,0 +1,7 @@
+#include "scy/crypto/rsa.h"
+
+namespace scy {
+namespace crypto {
+
+	
+} } // namespace scy::crypto
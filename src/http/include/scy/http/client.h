@@ -0,0 +1,461 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef SCY_HTTP_Client_H
+#define SCY_HTTP_Client_H
+
+
+#include "scy/net/socket.h"
+#include "scy/net/tcpsocket.h"
+#include "scy/net/sslsocket.h"
+#include "scy/net/network.h"
+#include "scy/http/connection.h"
+#include "scy/http/websocket.h"
+#include "scy/timer.h"
+#include <map>
+#include <deque>
+
+
+namespace scy { 
+namespace http {
+
+	
+class ProgressSignal: public Signal<const double&>
+{
+public:
+	void* sender;
+	UInt64 current;
+	UInt64 total;
+
+	ProgressSignal() :	
+		sender(nullptr), current(0), total(0) {}
+
+	double progress() const 
+	{
+		return (current / (total * 1.0)) * 100;
+	}
+
+	void update(int nread) 
+	{
+		current += nread;
+		//assert(current <= total);
+		emit(sender ? sender : this, progress());
+	}
+};
+
+
+class Client;
+class ClientConnection: public Connection
+{
+public:
+	typedef std::shared_ptr<ClientConnection> Ptr;
+
+    ClientConnection(const URL& url, const net::Socket::Ptr& socket = nullptr);
+		// Create a standalone connection with the given host.
+
+    virtual ~ClientConnection();
+
+	virtual void send();
+		// Sends the HTTP request.
+		//
+		// Calls connect() internally if the socket is not
+		// already connecting or connected. The actual request 
+		// will be sent when the socket is connected.
+				
+	virtual void send(http::Request& req);
+		// Sends the given HTTP request.
+		// The given request will overwrite the internal HTTP
+		// request object.
+		//
+		// Calls connect() internally if the socket is not
+		// already connecting or connected. The actual request 
+		// will be sent when the socket is connected.
+			
+	virtual int send(const char* data, std::size_t len, int flags = 0);
+	//virtual int send(const std::string& buf, int flags = 0);
+	//virtual void sendData(const char* buf, std::size_t len); //, int flags = 0
+	//virtual void sendData(const std::string& buf); //, int flags = 0
+		// Sends raw data to the peer.
+		// Calls send() internally.
+	
+	virtual void close();
+		// Forcefully closes the HTTP connection.
+		
+	const URL& url() const;
+		// Returns the connection URL.
+
+	bool reused() const;
+		// Returns true if the connection was given an already
+		// connected socket from the Client connection pool.
+
+	virtual void setReadStream(std::ostream* os);
+		// Set the output stream for writing response data to.
+		// The stream pointer is managed internally,
+		// and will be freed along with the connection.		
+		
+	template<class T>
+	T* readStream()
+		// Returns the cast read stream pointer or nullptr.
+	{
+		return dynamic_cast<T*>(_readStream);
+	}
+		
+	void* opaque;
+		// Optional unmanaged client data pointer.
+	
+	//
+	/// Internal callbacks
+
+	virtual void onHeaders();
+	virtual void onPayload(const MutableBuffer& buffer);
+	virtual void onMessage();
+	virtual void onComplete();
+	virtual void onClose();
+
+	//
+	/// Status signals
+
+	NullSignal Connect;						// Fires when the client socket is connected
+	Signal<Response&> Headers;				// Fires when the response HTTP header has been received
+	Signal<const Response&> Complete;		// Always on success or error response
+	ProgressSignal IncomingProgress;		// Notifies on download progress
+	ProgressSignal OutgoingProgress;		// Notifies on upload progress
+
+protected:		
+	virtual void connect();
+		// Connects to the server endpoint.
+		// All sent data is buffered until the connection is made.
+					
+	http::Client* client();
+	http::Message* incomingHeader();	
+	http::Message* outgoingHeader();
+	
+	void onSocketConnect();
+	void onHostResolved(void*, const net::DNSResult& result);
+
+	bool reusable() const;
+		// Returns true if the response is complete and both
+		// peers agreed to keep the connection alive.
+
+	void releaseSocket();
+		// Detaches the socket from the connection once the response 
+		// is complete, so it may be reused by the connection pool.
+		// The socket will not be closed along with the connection.
+	
+protected:	
+	URL _url;
+	std::ostream* _readStream;
+	std::vector<std::string> _outgoingBuffer;
+	bool _complete;
+	bool _connect;
+	bool _messageComplete;
+	bool _reused;
+	bool _released;
+
+	friend class Client;
+};
+
+
+typedef std::vector<ClientConnection::Ptr> ClientConnectionPtrVec;
+
+
+//
+// Client Connection Adapter
+//
+
+
+class ClientAdapter: public ConnectionAdapter
+{
+public:
+    ClientAdapter(ClientConnection& connection) : 
+		ConnectionAdapter(connection, HTTP_RESPONSE)
+	{
+	}
+};
+
+
+//
+// HTTP Connection Helpers
+//
+	
+	
+template<class ConnectionT>
+inline ClientConnection::Ptr createConnectionT(const URL& url, uv::Loop* loop = uv::defaultLoop())
+{
+	ClientConnection::Ptr conn;
+
+	if (url.scheme() == "http") {			
+		//conn = std::make_shared<ConnectionT>(url, std::make_shared<net::TCPSocket>(loop));
+		conn = std::shared_ptr<ConnectionT>(
+			new ConnectionT(url, std::make_shared<net::TCPSocket>(loop)), 
+				deleter::Deferred<ConnectionT>());
+	}
+	else if (url.scheme() == "https") {
+		//conn = std::make_shared<ConnectionT>(url, std::make_shared<net::SSLSocket>(loop));
+		conn = std::shared_ptr<ConnectionT>(
+			new ConnectionT(url, std::make_shared<net::SSLSocket>(loop)), 
+				deleter::Deferred<ConnectionT>());
+	}
+	else if (url.scheme() == "ws") {
+		//conn = std::make_shared<ConnectionT>(url, std::make_shared<net::TCPSocket>(loop));
+		conn = std::shared_ptr<ConnectionT>(
+			new ConnectionT(url, std::make_shared<net::TCPSocket>(loop)), 
+				deleter::Deferred<ConnectionT>());
+		conn->replaceAdapter(new ws::ConnectionAdapter(*conn, ws::ClientSide)); 
+		//replaceAdapter(new ws::ws::ConnectionAdapter(*conn, ws::ClientSide));
+	}
+	else if (url.scheme() == "wss") {
+		//conn = std::make_shared<ConnectionT>(url, std::make_shared<net::SSLSocket>(loop));
+		conn = std::shared_ptr<ConnectionT>(
+			new ConnectionT(url, std::make_shared<net::SSLSocket>(loop)), 
+				deleter::Deferred<ConnectionT>());
+		conn->replaceAdapter(new ws::ConnectionAdapter(*conn, ws::ClientSide));
+	}
+	else
+		throw std::runtime_error("Unknown connection type for URL: " + url.str());
+
+	return conn;
+}
+
+
+//
+// HTTP Connection Pool
+//
+
+
+class ConnectionPool
+	/// ConnectionPool keeps idle keep-alive client sockets per origin
+	/// (scheme, host and port) so subsequent requests can skip DNS,
+	/// TCP and TLS setup.
+	///
+	/// Idle sockets are closed once they have been unused for the
+	/// idle timeout, or if the server closes or writes to them.
+	/// Only sockets running on the pool's event loop are kept.
+{
+public:
+	struct Options
+	{
+		bool enabled;
+		std::size_t maxIdlePerHost;	// Maximum idle sockets kept per origin
+		Int64 idleTimeout;			// Milliseconds before an idle socket is closed
+
+		Options() : 
+			enabled(true), maxIdlePerHost(6), idleTimeout(30000) {}
+	};
+
+	struct Stats
+	{
+		UInt64 hits;		// Requests served by an idle socket
+		UInt64 misses;		// Requests which needed a new socket
+		UInt64 released;	// Sockets returned to the pool
+		UInt64 evicted;		// Idle sockets closed by timeout or peer
+		std::size_t idle;	// Idle sockets currently pooled
+
+		Stats() : 
+			hits(0), misses(0), released(0), evicted(0), idle(0) {}
+
+		double hitRate() const
+		{
+			return hits + misses ? (hits * 1.0) / (hits + misses) : 0;
+		}
+	};
+
+	ConnectionPool(uv::Loop* loop = uv::defaultLoop());
+	virtual ~ConnectionPool();
+
+	net::Socket::Ptr acquire(const URL& url, uv::Loop* loop = uv::defaultLoop());
+		// Returns a connected idle socket for the URL origin,
+		// or nullptr if none is available.
+
+	bool release(const URL& url, const net::Socket::Ptr& socket);
+		// Returns a connected socket to the pool.
+		// Returns false if the pool is full or disabled, 
+		// in which case the caller retains ownership.
+
+	void clear();
+		// Closes all idle sockets.
+
+	Options& options();
+	Stats stats() const;
+
+	static std::string origin(const URL& url);
+		// Returns the pool key for the given URL.
+
+protected:
+	struct Entry: public net::SocketAdapter
+	{
+		net::Socket::Ptr socket;
+		Int64 expires;
+		bool dead;
+
+		Entry(const net::Socket::Ptr& socket, Int64 expires) : 
+			socket(socket), expires(expires), dead(false) {}
+
+		// Idle sockets are unusable once the peer 
+		// closes or sends unsolicited data.
+		void onSocketRecv(const MutableBuffer&, const net::Address&) { dead = true; }
+		void onSocketError(const scy::Error&) { dead = true; }
+		void onSocketClose() { dead = true; }
+	};
+
+	void evict(Entry* entry);
+	void onTimer(void*);
+
+	typedef std::map<std::string, std::deque<Entry*>> EntryMap;
+
+	uv::Loop* _loop;
+	Options _options;
+	Stats _stats;
+	EntryMap _entries;
+	Timer _timer;
+};
+
+
+//
+// HTTP Client
+//
+
+
+class Client
+{
+public:
+	Client();
+	virtual ~Client();
+
+	static Client& instance();
+		// Returns the default HTTP Client singleton.
+
+	static void destroy();
+		// Destroys the default HTTP Client singleton.
+
+	void shutdown();
+		// Shutdown the Client and close all connections.
+
+	template<class ConnectionT>
+	ClientConnection::Ptr createConnectionT(const URL& url, uv::Loop* loop = uv::defaultLoop())
+	{
+		ClientConnection::Ptr connection;
+		
+		// Reuse an idle keep-alive socket for plain HTTP(S) requests
+		auto socket = (url.scheme() == "http" || url.scheme() == "https") ? 
+			_pool.acquire(url, loop) : nullptr;
+		if (socket) {
+			connection = std::shared_ptr<ConnectionT>(
+				new ConnectionT(url, socket), 
+					deleter::Deferred<ConnectionT>());
+			connection->_reused = true;
+		}
+		else
+			connection = http::createConnectionT<ConnectionT>(url, loop);
+        if (connection) {
+            addConnection(connection);
+        }
+		return connection;
+	}
+
+	ClientConnection::Ptr createConnection(const URL& url, uv::Loop* loop = uv::defaultLoop())
+	{
+		return createConnectionT<ClientConnection>(url, loop);
+	}
+
+	virtual void addConnection(ClientConnection::Ptr conn);
+	virtual void removeConnection(ClientConnection* conn);
+
+	ConnectionPool& pool();
+		// Returns the keep-alive connection pool.
+		//
+		// Completed keep-alive responses return their socket to 
+		// the pool, and the connection is closed once Complete
+		// listeners have been called.
+
+	NullSignal Shutdown;
+
+protected:		
+	//void onConnectionTimer(void*);
+	void onConnectionComplete(void* sender, const Response& response);
+	void onConnectionReleased(void* sender, const Response& response);
+	void onConnectionClose(void*);
+
+	friend class ClientConnection;
+	
+	ClientConnectionPtrVec _connections;
+	ConnectionPool _pool;
+	//Timer _timer;
+};
+
+inline ClientConnection::Ptr createConnection(const URL& url, http::Client* client = nullptr, uv::Loop* loop = uv::defaultLoop())
+{
+    auto connection = createConnectionT<ClientConnection>(url, loop);
+    if (client && connection)
+        client->addConnection(connection);
+
+    return connection;
+}
+
+
+#if 0
+class SecureClientConnection: public ClientConnection
+{
+public:
+    SecureClientConnection(Client* client, const URL& url) : //, const net::Address& address
+		ClientConnection(client, url, net::SSLSocket()) //, address
+	{
+	}
+
+	virtual ~SecureClientConnection() 
+	{
+	}
+};
+
+
+class WebSocketClientConnection: public ClientConnection
+{
+public:
+    WebSocketClientConnection(Client* client, const URL& url) : //, const net::Address& address
+		ClientConnection(client, url) //, address
+	{
+		socket().replaceAdapter(new ws::ConnectionAdapter(*this, ws::ClientSide));	//&socket(), &request(), request(), request()
+	}
+
+	virtual ~WebSocketClientConnection() 
+	{
+	}
+};
+
+
+class WebSocketSecureClientConnection: public ClientConnection
+{
+public:
+    WebSocketSecureClientConnection(Client* client, const URL& url) : //, const net::Address& address
+		ClientConnection(client, url, net::SSLSocket()) //, address
+	{
+		socket().replaceAdapter(new ws::ConnectionAdapter(*this, ws::ClientSide)); //(&socket(), &request()
+	}
+
+	virtual ~WebSocketSecureClientConnection() 
+	{
+	}
+};
+#endif
+
+
+} } // namespace scy::http
+
+
+#endif
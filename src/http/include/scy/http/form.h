@@ -0,0 +1,443 @@
+#ifndef SCY_HTTP_Form_H
+#define SCY_HTTP_Form_H
+
+
+#include "scy/collection.h"
+#include "scy/packetstream.h"
+#include "scy/thread.h"
+#include "scy/net/socket.h"
+#include "scy/net/types.h"
+#include "scy/uv/uvpp.h"
+#include <fstream>
+#include <memory>
+
+
+namespace scy {
+namespace http {
+
+
+class Request;
+class ClientConnection;
+class FormPart;
+
+
+//
+// HTML Form Writer
+//
+
+
+class FormWriter: public NVCollection, public PacketSource, public async::Startable
+	/// FormWriter is a HTTP client connection adapter for writing HTML forms.
+	///
+	/// This class is driven by the connection socket's Drain signal, so 
+	/// the next chunk is only written once the previous one has been 
+	/// flushed. File parts are read on the libuv threadpool and resume 
+	/// the writer when their data is ready, so big uploads neither block 
+	/// nor spin the event loop.
+	/// Class members are not synchronized hence they should not be accessed 
+	/// while the form is sending, not that there would be any reason to do so.
+{
+public:
+	static FormWriter* create(ClientConnection& conn, const std::string& encoding = FormWriter::ENCODING_URL);
+		// Creates the FormWriter that uses the given connection and
+		// encoding type.
+		//
+		// Encoding must be either "application/x-www-form-urlencoded"
+		// (which is the default) or "multipart/form-data".
+		
+	virtual ~FormWriter();
+		// Destroys the FormWriter.
+
+	void addPart(const std::string& name, FormPart* part);
+		// Adds an part/attachment (file upload) to the form.
+		//
+		// The form takes ownership of the FilePart and deletes it when it
+		// is no longer needed. The part will only be sent if the encoding
+		// set for the form is "multipart/form-data"
+		
+	void start();
+		// Starts sending the form on the next loop iteration.
+		
+	void stop();
+		// Stops sending the form.
+
+	bool complete() const;
+		// Returns true if the request is complete.
+
+	bool cancelled() const;
+		// Returns true if the request is cancelled.
+		
+	void prepareSubmit();
+		// Prepares the outgoing HTTP request object for submitting the form.
+		//
+		// If the request method is GET, the encoded form is appended to the
+		// request URI as query std::string. Otherwise (the method is
+		// POST), the form's content type is set to the form's encoding.
+		// The form's parameters must be written to the
+		// request body separately, with a call to write.
+		// If the request's HTTP version is HTTP/1.0:
+		//    - persistent connections are disabled
+		//    - the content transfer encoding is set to identity encoding
+		// Otherwise, if the request's HTTP version is HTTP/1.1:
+		//    - the request's persistent connection state is left unchanged
+		//    - the content transfer encoding is set to chunked
+		
+	UInt64 calculateMultipartContentLength();
+		// Processes the entire stream and calculates the content length.
+		// Not used for chunked encoding.
+
+	void writeUrl(std::ostream& ostr);
+		// Writes "application/x-www-form-urlencoded" encoded data to
+		// the client connection.
+	
+#if 0
+	void writeMultipart();
+		// Writes the complete "multipart/form-data" request to the 
+		// client connection. This method is blocking, and should be 
+		// called from a thread, especially when sending large files.
+#endif
+
+	void writeMultipartChunk();
+		// Writes the next multipart "multipart/form-data" encoded
+		// to the client connection. This method is non-blocking,
+		// and is suitable for use with the event loop.
+
+	void writeAsync();
+		// Called when the socket has drained or a part has data ready
+		// to write the next message chunk.
+		// If "multipart/form-data" the next multipart chunk will be written.
+		// If "application/x-www-form-urlencoded" the entire message will be written.
+		// The complete flag will be set when the entire request has been written.
+
+	void setEncoding(const std::string& encoding);
+		// Sets the encoding used for posting the form.
+		//
+		// Encoding must be either "application/x-www-form-urlencoded"
+		// (which is the default) or "multipart/form-data".
+		
+	const std::string& encoding() const;
+		// Returns the encoding used for posting the form.
+
+	void setBoundary(const std::string& boundary);
+		// Sets the boundary to use for separating form parts.
+		// Must be set before prepareSubmit() is called.
+
+	const std::string& boundary() const;
+		// Returns the MIME boundary used for writing multipart form data.
+
+	ClientConnection& connection();
+		// The associated HTTP client connection.
+
+	bool writable();
+		// Returns true once the connection socket has flushed all
+		// queued writes. Parts are paced by this so data is never 
+		// buffered faster than the peer accepts it.
+			
+	PacketSignal emitter;
+		// The outgoing packet emitter.
+
+	static const char* ENCODING_URL;               /// "application/x-www-form-urlencoded"
+	static const char* ENCODING_MULTIPART_FORM;    /// "multipart/form-data"
+	static const char* ENCODING_MULTIPART_RELATED; /// "multipart/related" http://tools.ietf.org/html/rfc2387
+	
+protected:
+	FormWriter(ClientConnection& conn, const std::string& encoding = FormWriter::ENCODING_URL);
+		// Creates the FormWriter that uses the given encoding.
+		//
+		// Encoding must be either "application/x-www-form-urlencoded"
+		// (which is the default) or "multipart/form-data".
+
+	FormWriter(const FormWriter&);
+	FormWriter& operator = (const FormWriter&);
+		
+	void writePartHeader(const NVCollection& header, std::ostream& ostr);
+		// Writes the message boundary std::string, followed
+		// by the message header to the output stream.
+		
+	void writeEnd(std::ostream& ostr);
+		// Writes the final boundary std::string to the output stream.
+
+	static std::string createBoundary();
+		// Creates a random boundary std::string.
+		//
+		// The std::string always has the form boundary-XXXXXXXXXXXX, 
+		// where XXXXXXXXXXXX is a randomly generate number.
+
+	virtual void updateProgress(int nread);
+		// Updates the upload progress via the associated 
+		// ClientConnection object.
+
+	void onSocketDrain();
+		// Writes the next chunk once queued writes have flushed.
+
+	void detach();
+		// Stops the start timer and socket notifications.
+	
+	friend class FormPart;
+	friend class FilePart;
+	friend class StringPart;
+
+	struct Part
+	{
+		std::string name;
+		FormPart* part;
+	};
+	
+	typedef std::deque<Part> PartQueue;
+	
+	ClientConnection& _connection;
+	net::Socket::Ptr _socket;
+	uv::Handle* _timer;    // Defers the first write out of start()
+	std::string _encoding;
+	std::string _boundary;
+	PartQueue _parts;
+	UInt64 _filesLength;
+	int _writeState;
+	bool _initial;
+	bool _complete;
+	bool _cancelled;
+};
+
+
+//
+// Form Part
+//
+
+
+class FormPart
+	/// An implementation of FormPart.
+{
+public:	
+	FormPart(const std::string& contentType = "application/octet-stream");
+		// Creates the FormPart with the given MIME type.
+
+	virtual ~FormPart();
+		// Destroys the FormPart.
+		
+	virtual void reset();
+		// Reset the internal state and write position to the start.
+
+	virtual bool writeChunk(FormWriter& writer) = 0;
+		// Writes a form data chunk to the given HTTP client connection.
+		// Returns true if there is more data to be written.
+
+	virtual void write(FormWriter& writer) = 0;
+		// Writes the form data to the given HTTP client connection.
+
+	virtual void write(std::ostream& ostr) = 0;
+		// Writes the form data to the given output stream.	
+				
+	NVCollection& headers();
+		// Returns a NVCollection containing additional header 
+		// fields for the part.	
+		
+	virtual bool initialWrite() const;
+		// Returns true if this is the initial write.
+	
+	const std::string& contentType() const;
+		// Returns the MIME type for this part or attachment.
+		
+	virtual UInt64 length() const = 0;
+		// Returns the length of the current part.
+
+protected:
+	std::string _contentType;
+	UInt64 _length;
+	NVCollection _headers;
+	bool _initialWrite;
+};
+
+
+//
+// File Part
+//
+
+
+class FilePart: public FormPart
+	/// An implementation of FilePart for plain files.
+{
+public:
+	FilePart(const std::string& path);
+		// Creates the FilePart for the given path.
+		//
+		// The MIME type is set to application/octet-stream.
+		//
+		// Throws an FileException if the file cannot be opened.
+	
+	FilePart(const std::string& path, const std::string& contentType);
+		// Creates the FilePart for the given
+		// path and MIME type.
+		//
+		// Throws an FileException if the file cannot be opened.
+
+	FilePart(const std::string& path, const std::string& filename, const std::string& contentType);
+		// Creates the FilePart for the given
+		// path and MIME type. The given filename is 
+		// used as part filename (see filename()) only.
+		//
+		// Throws an FileException if the file cannot be opened.
+
+	virtual ~FilePart();
+		// Destroys the FilePart.
+
+	virtual void open();
+		// Opens the file.
+		//
+		// Throws an FileException if the file cannot be opened.
+		
+	virtual void reset();
+		// Reset the internal state and write position to the start.
+
+	virtual bool writeChunk(FormWriter& writer);
+		// Writes a form data chunk to the given HTTP client connection.
+		// Returns true if there is more data to be written.
+
+	virtual void write(FormWriter& writer);
+		// Writes the form data to the given HTTP client connection.
+
+	virtual void write(std::ostream& ostr);
+		// Writes the form data to the given output stream.	
+		
+	const std::string& filename() const;
+		// Returns the filename portion of the path.
+
+	std::ifstream& stream();
+		// Returns a file input stream, opened on first use.
+		//
+		// Deprecated: Parts are read through libuv, so this stream 
+		// is separate from the upload and only kept for callers 
+		// which read the file directly.
+		
+	virtual UInt64 length() const;
+		// Returns the length of the current part.
+
+	void setSendFile(bool flag);
+		// Enables zero-copy sendfile() uploads when the connection 
+		// is a plain TCP socket without chunked transfer encoding.
+		// Buffered reads are used otherwise.
+
+	/*				
+	NVCollection& headers();
+		// Returns a NVCollection containing additional header 
+		// fields for the part.	
+	
+	const std::string& contentType() const;
+		// Returns the MIME type for this part or attachment.
+		
+	UInt64 fileSize() const;
+		// Returns the file size.
+		*/
+
+protected:
+	struct File;
+	struct ReadRequest;
+	struct SendRequest;
+
+	void prefetch(FormWriter& writer);
+		// Starts reading ahead into free buffers on the libuv
+		// threadpool, so the event loop never blocks on disk.
+
+	bool sendFile(FormWriter& writer);
+		// Writes the file with sendfile() on the threadpool.
+
+	void waitWritable(FormWriter& writer);
+		// Polls the socket until it can take more data after 
+		// a sendfile() call has filled its buffer.
+
+	void closePoll();
+
+	int readFile(char* data, std::size_t size, UInt64 offset);
+		// Reads from the file synchronously for the blocking 
+		// write() methods. Returns the number of bytes read.
+
+	void cancelRequests();
+
+	//std::string _contentType;
+	std::string _path;
+	std::string _filename;
+	UInt64 _fileSize;
+	std::shared_ptr<File> _file;
+	std::ifstream _istr;
+	ReadRequest* _reads[2];
+	SendRequest* _send;
+	uv::Handle* _poll;     // Socket writability poll for sendfile()
+	int _pollFd;           // The duplicate socket descriptor polled
+	bool _writeWait;
+	UInt64 _readOffset;
+	UInt64 _emitOffset;
+	int _readIndex;
+	int _emitIndex;
+	bool _sendFile;
+	FormWriter* _writer;   // Resumed when async reads and sends complete
+	//UInt64 _nWritten;
+	//NVCollection _headers;	
+};
+
+
+//
+// String Part
+//
+
+
+class StringPart: public FormPart
+	/// An implementation of StringPart for plain files.
+{
+public:
+	StringPart(const std::string& path);
+		// Creates the StringPart for the given string.
+	
+	StringPart(const std::string& data, const std::string& contentType);
+		// Creates the StringPart for the given string and MIME type.
+
+	virtual ~StringPart();
+		// Destroys the StringPart.
+
+	virtual bool writeChunk(FormWriter& writer);
+		// Writes a form data chunk to the given HTTP client connection.
+		// Returns true if there is more data to be written.
+
+	virtual void write(FormWriter& writer);
+		// Writes the form data to the given HTTP client connection.
+
+	virtual void write(std::ostream& ostr);
+		// Writes the form data to the given output stream.	
+		
+	virtual UInt64 length() const;
+		// Returns the length of the current part.
+
+protected:
+	std::string _data;
+};
+
+
+} } // namespace scy::http
+
+
+#endif // SCY_HTTP_Form_H
+
+
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
@@ -0,0 +1,587 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "scy/http/client.h"
+#include "scy/logger.h"
+#include "scy/util.h"
+
+
+using std::endl;
+
+
+namespace scy { 
+namespace http {
+
+
+//
+// Client Connection
+//
+
+
+ClientConnection::ClientConnection(const URL& url, const net::Socket::Ptr& socket) :
+	Connection(socket),
+	_url(url),
+	_readStream(nullptr), 
+	_complete(false),
+	_connect(false),
+	_messageComplete(false),
+	_reused(false),
+	_released(false)
+{	
+	TraceLS(this) << "Create: " << url << endl;
+
+	IncomingProgress.sender = this;
+	OutgoingProgress.sender = this;
+			
+	_request.setURI(url.pathEtc());
+	_request.setHost(url.host(), url.port());
+	
+	// Set default error status
+	_response.setStatus(http::StatusCode::BadGateway);
+
+	replaceAdapter(new ClientAdapter(*this));
+}
+
+
+ClientConnection::~ClientConnection() 
+{	
+	TraceLS(this) << "Destroy" << endl;
+
+	if (_readStream) {
+		delete _readStream;
+		_readStream = nullptr;
+	}
+}
+
+
+void ClientConnection::close()
+{
+	if (!closed()) {
+		onComplete();
+		if (_released) {
+			// The socket belongs to the connection pool now
+			_closed = true;
+			onClose();
+		}
+		else
+			Connection::close();
+	}
+}
+
+
+void ClientConnection::send()
+{
+	assert(!_connect);
+	connect();
+}
+
+
+void ClientConnection::send(http::Request& req)
+{
+	assert(!_connect);
+	_request = req;
+	connect();
+}
+
+
+int ClientConnection::send(const char* data, std::size_t len, int flags)
+{
+	connect();
+	if (Outgoing.active())
+		return Connection::send(data, len);
+	else
+		_outgoingBuffer.push_back(std::string(data, len));	
+	return len;
+}
+
+
+#if 0
+int ClientConnection::send(const std::string& buf, int flags) //, int flags
+{
+	connect();
+	if (Outgoing.active())
+		return Connection::send(buf);
+	else
+		_outgoingBuffer.push_back(buf);	
+	return buf.length();
+}
+
+
+void ClientConnection::sendData(const char* buf, std::size_t len) //, int flags
+{
+	connect();
+	if (Outgoing.active())
+		Connection::sendData(buf, len);
+	else
+		_outgoingBuffer.push_back(std::string(buf, len));	
+}
+
+	
+http::Client* ClientConnection::client()
+{
+	return _client;
+}
+#endif
+
+
+void ClientConnection::connect()
+{
+	if (!_connect) {
+		_connect = true;
+		if (_reused) {
+			// Pooled sockets are already connected
+			TraceLS(this) << "Reusing connected socket" << endl;	
+			onSocketConnect();
+		}
+		else {
+			TraceLS(this) << "Connecting" << endl;	
+			_socket->connect(_url.host(), _url.port());
+		}
+	}
+}
+
+
+bool ClientConnection::reusable() const
+{
+	// Upgraded (WebSocket) connections are never reusable
+	return !closed() && !_released && _messageComplete && !_socket->closed() &&
+		(_url.scheme() == "http" || _url.scheme() == "https") &&
+		_response.getStatus() != StatusCode::SwitchingProtocols &&
+		_request.getKeepAlive() && _response.getKeepAlive();
+}
+
+
+void ClientConnection::releaseSocket()
+{
+	TraceLS(this) << "Release socket" << endl;	
+	assert(reusable());
+
+	// Unhook the adapter without deleting it, since we are 
+	// likely being called from inside its parser callback.
+	if (_adapter) {
+		Outgoing.emitter.detach(_adapter);
+		_socket->removeReceiver(_adapter);
+	}
+	_released = true;
+}
+
+
+const URL& ClientConnection::url() const
+{
+	return _url;
+}
+
+
+bool ClientConnection::reused() const
+{
+	return _reused;
+}
+
+
+void ClientConnection::setReadStream(std::ostream* os)
+{
+	assert(!_connect);
+	if (_readStream) {
+		delete _readStream;
+	}
+
+	_readStream = os;
+}
+
+
+http::Message* ClientConnection::incomingHeader() 
+{ 
+	return static_cast<http::Message*>(&_response);
+}
+
+
+http::Message* ClientConnection::outgoingHeader() 
+{ 
+	return static_cast<http::Message*>(&_request);
+}
+
+
+//
+// Socket Callbacks
+
+void ClientConnection::onSocketConnect() 
+{
+	TraceLS(this) << "On connect" << endl;
+	
+	// Emit the connect signal so raw connections like
+	// websockets can kick off the data flow
+	Connect.emit(this);
+
+	// Start the outgoing send stream if there are
+	// any queued packets or adapters attached
+	Outgoing.start();
+
+	// Flush queued packets
+	if (!_outgoingBuffer.empty()) {
+		for (const auto & packet : _outgoingBuffer) {
+			Outgoing.write(packet.c_str(), packet.length());
+		}
+		_outgoingBuffer.clear();
+	}
+
+	// Send the outgoing HTTP header if it hasn't already been sent. 
+	// Note the first call to socket().send() will flush headers.
+	// Note if there are stream adapters we wait for the stream to push
+	// through any custom headers. See ChunkedAdapter::emitHeader
+	else if (Outgoing.numAdapters() == 0) {
+		TraceLS(this) << "On connect: Send header" << endl;
+		sendHeader();
+	}	
+}
+	
+
+//
+// Connection Callbacks
+
+void ClientConnection::onHeaders() 
+{
+	TraceLS(this) << "On headers" << endl;	
+	IncomingProgress.total = _response.getContentLength();
+
+	Headers.emit(this, _response);
+}
+
+
+void ClientConnection::onPayload(const MutableBuffer& buffer)
+{
+	//TraceLS(this) << "On payload: " << 
+	// std::string(bufferCast<const char*>(buffer), buffer.size()) << endl;	
+	
+	// Update download progress
+	IncomingProgress.update(buffer.size());
+
+	if (_readStream) {		
+		TraceLS(this) << "Writing to stream: " << buffer.size() << endl;	
+		_readStream->write(bufferCast<const char*>(buffer), buffer.size());
+		_readStream->flush();
+	}
+
+	//Payload.emit(this, buffer);
+}
+
+
+void ClientConnection::onMessage() 
+{
+	TraceLS(this) << "On complete" << endl;
+
+	_messageComplete = true;
+	onComplete();
+}
+
+	
+void ClientConnection::onComplete()
+{
+	if (!_complete) {
+		_complete = true; // in case close() is called inside callback 
+		Complete.emit(this, _response);
+	}
+}
+
+
+void ClientConnection::onClose() 
+{
+	TraceLS(this) << "On close" << endl;	
+
+	Connection::onClose();
+}
+
+
+//
+// HTTP Client
+//
+
+
+Singleton<Client>& singleton() 
+{
+	static Singleton<Client> singleton;
+	return singleton;
+}
+
+
+Client& Client::instance() 
+{
+	return *singleton().get();
+}
+	
+
+void Client::destroy()
+{
+	singleton().destroy();
+}
+
+
+Client::Client()
+{
+	TraceLS(this) << "Create" << endl;
+
+	//_timer.Timeout += sdelegate(this, &Client::onConnectionTimer);
+	//_timer.start(5000);
+}
+
+
+Client::~Client()
+{
+	TraceLS(this) << "Destroy" << endl;
+	shutdown();
+}
+
+
+void Client::shutdown() 
+{
+	TraceLS(this) << "Shutdown" << endl;
+
+	//_timer.stop();
+	Shutdown.emit(this);
+
+	//_connections.clear();
+	auto conns = _connections;
+	for (auto conn : conns) {
+		conn->close(); // close and remove via callback
+	}
+	assert(_connections.empty());
+
+	_pool.clear();
+}
+
+
+void Client::addConnection(ClientConnection::Ptr conn) 
+{		
+	TraceLS(this) << "Adding connection: " << conn << endl;	
+
+	conn->Complete += sdelegate(this, &Client::onConnectionComplete, 100); // before listeners
+	conn->Complete += sdelegate(this, &Client::onConnectionReleased, -1); // after listeners
+	conn->Close += sdelegate(this, &Client::onConnectionClose, -1); // lowest priority
+	_connections.push_back(conn);
+}
+
+
+void Client::removeConnection(ClientConnection* conn) 
+{		
+	TraceLS(this) << "Removing connection: " << conn << endl;
+	for (auto it = _connections.begin(); it != _connections.end(); ++it) {
+		if (conn == it->get()) {
+			TraceLS(this) << "Removed connection: " << conn << endl;
+			_connections.erase(it);
+			return;
+		}
+	}
+	assert(0 && "unknown connection");
+}
+
+
+ConnectionPool& Client::pool()
+{
+	return _pool;
+}
+
+
+void Client::onConnectionComplete(void* sender, const Response&)
+{
+	// Hand keep-alive sockets to the pool before listeners run,
+	// so closing the connection from a Complete callback won't
+	// close the socket.
+	auto conn = reinterpret_cast<ClientConnection*>(sender);
+	if (conn->reusable() && _pool.release(conn->url(), conn->socket()))
+		conn->releaseSocket();
+}
+
+
+void Client::onConnectionReleased(void* sender, const Response&)
+{
+	// Released connections no longer see socket events,
+	// so close them once listeners are done.
+	auto conn = reinterpret_cast<ClientConnection*>(sender);
+	if (conn->_released)
+		conn->close();
+}
+
+
+void Client::onConnectionClose(void* sender)
+{
+	removeConnection(reinterpret_cast<ClientConnection*>(sender));
+}
+
+
+//
+// HTTP Connection Pool
+//
+
+
+ConnectionPool::ConnectionPool(uv::Loop* loop) :
+	_loop(loop),
+	_timer(loop)
+{
+	TraceLS(this) << "Create" << endl;
+	_timer.Timeout += sdelegate(this, &ConnectionPool::onTimer);
+}
+
+
+ConnectionPool::~ConnectionPool()
+{
+	TraceLS(this) << "Destroy" << endl;
+	clear();
+}
+
+
+std::string ConnectionPool::origin(const URL& url)
+{
+	return url.scheme() + "://" + url.host() + ":" + util::itostr<UInt16>(url.port());
+}
+
+
+net::Socket::Ptr ConnectionPool::acquire(const URL& url, uv::Loop* loop)
+{
+	if (!_options.enabled || loop != _loop)
+		return nullptr;
+
+	auto it = _entries.find(origin(url));
+	while (it != _entries.end() && !it->second.empty()) {
+
+		// Most recently used first
+		Entry* entry = it->second.back();
+		it->second.pop_back();
+		_stats.idle--;
+		if (entry->dead || entry->socket->closed()) {
+			evict(entry);
+			continue;
+		}
+
+		TraceLS(this) << "Reusing socket: " << origin(url) << endl;
+		auto socket = entry->socket;
+		socket->removeReceiver(entry);
+		delete entry;
+
+		// Each reuse detaches an adapter and an entry, which are only
+		// cancelled. Purge them from the signals that aren't emitted
+		// while the socket is idle, or the lists grow with every reuse.
+		socket->Connect.cleanup();
+		socket->Error.cleanup();
+		socket->Close.cleanup();
+		_stats.hits++;
+		return socket;
+	}
+
+	_stats.misses++;
+	return nullptr;
+}
+
+
+bool ConnectionPool::release(const URL& url, const net::Socket::Ptr& socket)
+{
+	if (!_options.enabled || socket->closed() || socket->loop() != _loop)
+		return false;
+
+	auto& entries = _entries[origin(url)];
+	if (entries.size() >= _options.maxIdlePerHost)
+		return false;
+
+	TraceLS(this) << "Releasing socket: " << origin(url) << endl;
+	auto entry = new Entry(socket, (Int64)uv_now(_loop) + _options.idleTimeout);
+	socket->addReceiver(entry);
+	entries.push_back(entry);
+	_stats.released++;
+	_stats.idle++;
+
+	// Sweep idle sockets while the pool is in use
+	if (!_timer.active())
+		_timer.start(1000, 1000);
+	return true;
+}
+
+
+void ConnectionPool::clear()
+{
+	for (auto& kv : _entries) {
+		for (auto entry : kv.second)
+			evict(entry);
+	}
+	_entries.clear();
+	_stats.idle = 0;
+	_timer.stop();
+}
+
+
+void ConnectionPool::evict(Entry* entry)
+{
+	entry->socket->removeReceiver(entry);
+	entry->socket->close();
+	delete entry;
+	_stats.evicted++;
+}
+
+
+void ConnectionPool::onTimer(void*)
+{
+	Int64 now = (Int64)uv_now(_loop);
+	for (auto it = _entries.begin(); it != _entries.end();) {
+		auto& entries = it->second;
+		for (auto eit = entries.begin(); eit != entries.end();) {
+			if ((*eit)->dead || (*eit)->expires <= now) {
+				TraceLS(this) << "Evicting idle socket: " << it->first << endl;
+				evict(*eit);
+				eit = entries.erase(eit);
+				_stats.idle--;
+			}
+			else
+				++eit;
+		}
+		if (entries.empty())
+			it = _entries.erase(it);
+		else
+			++it;
+	}
+	if (_entries.empty())
+		_timer.stop();
+}
+
+
+ConnectionPool::Options& ConnectionPool::options()
+{
+	return _options;
+}
+
+
+ConnectionPool::Stats ConnectionPool::stats() const
+{
+	return _stats;
+}
+
+
+#if 0
+void Client::onConnectionTimer(void*)
+{
+	// Close connections that have timed out while receiving
+	// the server response, maybe due to a faulty server.
+	auto conns = _connections;
+	for (auto conn : conns) {
+		if (conn->closed()) { // conn->expired()
+			TraceLS(this) << "Closing expired connection: " << conn << endl;
+			conn->close();
+		}			
+	}
+}
+#endif
+
+
+} } // namespace scy::http
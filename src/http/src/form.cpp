@@ -0,0 +1,1139 @@
+#include "scy/http/form.h"
+#include "scy/http/client.h"
+#include "scy/http/packetizers.h"
+#include "scy/http/url.h"
+#include "scy/filesystem.h"
+#include "scy/crypto/crypto.h"
+#include "scy/net/tcpsocket.h"
+#include "scy/net/sslsocket.h"
+#include <fcntl.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+#if __linux__
+#include <sys/epoll.h>
+#endif
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace scy {
+namespace http {
+
+
+//
+// Form Writer
+//
+
+
+const char* FormWriter::ENCODING_URL               = "application/x-www-form-urlencoded";
+const char* FormWriter::ENCODING_MULTIPART_FORM    = "multipart/form-data";
+const char* FormWriter::ENCODING_MULTIPART_RELATED = "multipart/related";
+
+const int FILE_CHUNK_SIZE = 65536; //32384;
+
+
+FormWriter* FormWriter::create(ClientConnection& conn, const std::string& encoding)
+{
+	auto wr = new http::FormWriter(conn, encoding);
+	conn.Outgoing.attachSource(wr, true, true);
+	if (conn.request().isChunkedTransferEncoding()) {
+		assert(encoding != http::FormWriter::ENCODING_URL);
+		assert(conn.request().getVersion() != http::Message::HTTP_1_0);
+		conn.Outgoing.attach(new http::ChunkedAdapter(&conn), 0, true);
+	}
+	conn.Outgoing.lock();
+	return wr;
+}
+
+
+FormWriter::FormWriter(ClientConnection& connection, const std::string& encoding) :
+	PacketSource(this->emitter),
+	_connection(connection),
+	_timer(nullptr),
+	_encoding(encoding),
+	_filesLength(0),
+	_writeState(0),
+	_initial(true),
+	_complete(false),
+	_cancelled(false)
+{
+}
+
+	
+FormWriter::~FormWriter()
+{
+	detach();
+	for (auto it = _parts.begin(); it != _parts.end(); ++it)
+		delete it->part;
+}
+
+
+void FormWriter::addPart(const std::string& name, FormPart* part)
+{
+	assert(part);
+	assert(_encoding != ENCODING_URL);
+
+	Part p;
+	p.part = part;
+	p.name = name;
+	_parts.push_back(p);
+
+	_filesLength += part->length();
+}
+
+
+void FormWriter::prepareSubmit()
+{	
+	TraceLS(this) << "Prepare submit" << std::endl;
+
+	http::Request& request = _connection.request();
+	if (request.getMethod() == http::Method::Post || 
+		request.getMethod() == http::Method::Put) {
+		if (_encoding == ENCODING_URL) {
+			request.setContentType(_encoding);
+			request.setChunkedTransferEncoding(false);
+			std::ostringstream ostr;
+			writeUrl(ostr);
+			assert(ostr.tellp() > 0);
+			request.setContentLength(ostr.tellp());
+		}
+		else {
+			if (_boundary.empty())
+				_boundary = createBoundary();
+			std::string ct(_encoding);
+			ct.append("; boundary=\"");
+			ct.append(_boundary);
+			ct.append("\"");
+			request.setContentType(ct);
+					
+			// Set the total file size for upload progress updates.
+			// This is not the HTTP content length as it does not 
+			// factor chunk headers.
+			if (!_parts.empty()) {
+				assert(_filesLength);
+				_connection.OutgoingProgress.total = _filesLength;
+			}
+			
+			// Set Content-Length for non-chunked transfers
+			if (!request.isChunkedTransferEncoding() && 
+				request.getVersion() != http::Message::HTTP_1_0)
+				request.setContentLength(calculateMultipartContentLength());
+		}
+		if (request.getVersion() == http::Message::HTTP_1_0) {
+			request.setKeepAlive(false);
+			request.setChunkedTransferEncoding(false);
+		}
+	}
+	else {
+		std::string uri = request.getURI();
+		std::ostringstream ostr;
+		writeUrl(ostr);
+		uri.append("?");
+		uri.append(ostr.str());
+		request.setURI(uri);
+	}
+}
+
+
+void FormWriter::start()
+{
+	TraceLS(this) << "Start" << std::endl;
+
+	prepareSubmit();
+	_cancelled = false;
+
+	// Each flushed write resumes the writer
+	_socket = _connection.socket();
+	auto stream = dynamic_cast<net::Stream*>(_socket.get());
+	if (stream)
+		stream->Drain += delegate(this, &FormWriter::onSocketDrain);
+
+	// Sources are started while the stream holds its processing 
+	// lock, so the first chunk is written from the loop instead
+	if (!_timer) {
+		_timer = new uv::Handle(_socket->loop(), new uv_timer_t);
+		_timer->ptr()->data = this;
+		uv_timer_init(_timer->loop(), _timer->ptr<uv_timer_t>());
+	}
+	uv_timer_start(_timer->ptr<uv_timer_t>(), [](uv_timer_t* handle) {
+		reinterpret_cast<FormWriter*>(handle->data)->writeAsync();
+	}, 0, 0);
+}
+
+
+void FormWriter::stop()
+{
+	TraceLS(this) << "Stop" << std::endl;
+
+	//_complete = true;
+	_cancelled = true;
+	detach();
+}
+
+
+void FormWriter::detach()
+{
+	if (_timer) {
+		delete _timer;
+		_timer = nullptr;
+	}
+	if (_socket) {
+		// Only cancel the delegate, as we may be inside a Drain callback
+		auto stream = dynamic_cast<net::Stream*>(_socket.get());
+		if (stream)
+			stream->Drain -= delegate(this, &FormWriter::onSocketDrain);
+		_socket.reset();
+	}
+}
+
+
+void FormWriter::onSocketDrain()
+{
+	writeAsync();
+}
+
+
+UInt64 FormWriter::calculateMultipartContentLength()
+{	
+	std::ostringstream ostr;
+	UInt64 length = 0;
+	for (NVCollection::ConstIterator it = begin(); it != end(); ++it) {
+		NVCollection header;			
+		if (_encoding == ENCODING_MULTIPART_FORM) {
+			std::string disp("form-data; name=\"");
+			disp.append(it->first);
+			disp.append("\"");
+			header.set("Content-Disposition", disp);
+		}
+		writePartHeader(header, ostr);
+		ostr << it->second;
+	}
+	for (PartQueue::const_iterator pit = _parts.begin(); pit != _parts.end(); ++pit) {
+		NVCollection header(pit->part->headers());
+		if (_encoding == ENCODING_MULTIPART_FORM) {
+			std::string disp("form-data; name=\"");
+			disp.append(pit->name);
+			disp.append("\"");
+			auto filePart = dynamic_cast<http::FilePart*>(pit->part);
+			if (filePart) {
+				std::string filename = filePart->filename();
+				if (!filename.empty()) {
+					disp.append("; filename=\"");
+					disp.append(filename);
+					disp.append("\"");
+				}
+			}
+			header.set("Content-Disposition", disp);
+		}
+		header.set("Content-Type", pit->part->contentType());
+		writePartHeader(header, ostr);
+
+		// Count part data rather than reading whole files into memory
+		length += pit->part->length();
+	}		
+	writeEnd(ostr);
+	return length + ostr.tellp();	
+}
+
+
+void FormWriter::writeAsync()
+{
+	// Parts and the socket may still call back once we are done
+	if (complete() || cancelled())
+		return;
+
+	try {		
+		// Wait for the socket to drain before writing more
+		if (!writable())
+			return;
+
+		if (encoding() == ENCODING_URL) {
+			std::ostringstream ostr;
+			writeUrl(ostr);					
+			TraceL << "Writing URL: " << ostr.str() << std::endl;
+			emit(ostr.str());
+			_complete = true;
+		} 
+		else
+			writeMultipartChunk();
+		if (complete())
+			detach();
+	}
+	catch (std::exception& exc) {
+		TraceLS(this) << "Error: " << exc.what() << std::endl;
+		assert(0);
+//#ifdef _DEBUG
+//		throw exc;
+//#endif
+	}
+}
+
+
+#if 0
+void FormWriter::writeMultipart()
+{
+	for (NVCollection::ConstIterator it = begin(); it != end(); ++it) {
+		std::ostringstream ostr;
+		NVCollection header;
+		std::string disp("form-data; name=\"");
+		disp.append(it->first);
+		disp.append("\"");
+		header.set("Content-Disposition", disp);
+		writePartHeader(header, ostr);
+		ostr << it->second;		
+		emit(ostr.str());
+	}	
+
+	for (PartQueue::const_iterator pit = _parts.begin(); pit != _parts.end(); ++pit) {
+		std::ostringstream ostr;
+		NVCollection header(pit->part->headers());
+		std::string disp("form-data; name=\"");
+		disp.append(pit->name);
+		disp.append("\"");
+		std::string filename = pit->part->filename();
+		if (!filename.empty()) {
+			disp.append("; filename=\"");
+			disp.append(filename);
+			disp.append("\"");
+		}
+		header.set("Content-Disposition", disp);
+		header.set("Content-Type", pit->part->contentType());
+		writePartHeader(header, ostr);		
+		emit(ostr.str());		
+		pit->part->write(*this);
+	}
+	
+	std::ostringstream ostr;
+	writeEnd(ostr);
+	emit(ostr.str());		
+	emit("0\r\n\r\n", 5, PacketFlags::NoModify | PacketFlags::Final);
+}
+#endif
+
+
+void FormWriter::writeMultipartChunk()
+{
+	TraceLS(this) << "Writing chunk: " << _writeState << std::endl;
+
+	switch(_writeState) {
+	
+	// Send form values
+	case 0:
+		for (NVCollection::ConstIterator it = begin(); it != end(); ++it) {
+			std::ostringstream ostr;
+			NVCollection header;			
+			if (_encoding == ENCODING_MULTIPART_FORM) {
+				std::string disp("form-data; name=\"");
+				disp.append(it->first);
+				disp.append("\"");
+				header.set("Content-Disposition", disp);
+			}
+			writePartHeader(header, ostr);
+			ostr << it->second;		
+			emit(ostr.str());
+		}
+		_writeState++;
+		// fall through
+
+	// Send file parts
+	//
+	// Parts which return early have either queued a socket write 
+	// or started async work, and either will resume the writer, 
+	// so states are chained until that happens.
+	case 1:
+		while (!_parts.empty()) {
+			auto& p = _parts.front();
+				
+			if (p.part->initialWrite()) {
+				std::ostringstream ostr;
+				NVCollection header(p.part->headers());
+				if (_encoding == ENCODING_MULTIPART_FORM) {
+					std::string disp("form-data; name=\"");
+					disp.append(p.name);
+					disp.append("\"");
+					auto filePart = dynamic_cast<http::FilePart*>(p.part);
+					if (filePart) {
+						std::string filename = filePart->filename();
+						if (!filename.empty()) {
+							disp.append("; filename=\"");
+							disp.append(filename);
+							disp.append("\"");
+						}
+					}
+					header.set("Content-Disposition", disp);
+				}
+				header.set("Content-Type", p.part->contentType());
+				writePartHeader(header, ostr);		
+				emit(ostr.str());	
+			}
+			if (p.part->writeChunk(*this)) {			
+				return; // return after writing a chunk
+			}
+
+			TraceLS(this) << "Part complete: " << p.name << std::endl;
+			delete p.part;
+			_parts.pop_front();
+		}
+		_writeState++;
+		// fall through
+		
+	// Send final packet
+	case 2: {
+		std::ostringstream ostr;
+		writeEnd(ostr);
+		emit(ostr.str());
+		
+		// HACK: Write chunked end code here. 
+		// The ChunkedAdapter should really be doing this.
+		
+		if (_connection.request().isChunkedTransferEncoding()) {
+			emit("0\r\n\r\n", 5, PacketFlags::NoModify | PacketFlags::Final);
+		}
+
+		TraceLS(this) << "Request complete" << std::endl;
+		_complete = true;
+		_writeState = -1; // raise error if called again
+		} break;
+	
+	// Invalid state
+	default:
+		ErrorLS(this) << "Invalid write state: " << _writeState << std::endl;
+		assert(0 && "invalid write state");
+		break;
+	}
+}
+
+
+void FormWriter::writeUrl(std::ostream& ostr)
+{
+	for (NVCollection::ConstIterator it = begin(); it != end(); ++it) {
+		if (it != begin()) ostr << "&";
+		ostr << URL::encode(it->first) << "=" << URL::encode(it->second);
+	}
+}
+
+
+void FormWriter::writePartHeader(const NVCollection& header, std::ostream& ostr)
+{
+	if (_initial) 
+		_initial = false;
+	else
+		ostr << "\r\n";
+	ostr << "--" << _boundary << "\r\n";
+
+	NVCollection::ConstIterator it = header.begin();
+	while (it != header.end()) {
+		ostr << it->first << ": " << it->second << "\r\n";
+		++it;
+	}
+	ostr << "\r\n";
+}
+
+	
+void FormWriter::writeEnd(std::ostream& ostr)
+{
+	ostr << "\r\n--" << _boundary << "--\r\n";
+}
+
+
+void FormWriter::updateProgress(int nread)
+{
+	_connection.OutgoingProgress.update(nread);
+}
+
+
+std::string FormWriter::createBoundary()
+{
+	return "boundary_" + util::randomString(8);
+}
+
+
+void FormWriter::setEncoding(const std::string& encoding)
+{
+	_encoding = encoding;
+}
+
+
+void FormWriter::setBoundary(const std::string& boundary)
+{
+	_boundary = boundary;
+}
+
+
+const std::string& FormWriter::encoding() const
+{
+	return _encoding;
+}
+
+
+const std::string& FormWriter::boundary() const
+{
+	return _boundary;
+}
+
+
+ClientConnection& FormWriter::connection()
+{
+	return _connection;
+}
+
+
+bool FormWriter::writable()
+{
+	// Emitted data may still be referenced by queued socket 
+	// writes, so nothing more is written until they complete.
+	auto socket = dynamic_cast<net::TCPSocket*>(_connection.socket().get());
+	return !socket || !socket->ptr() || 
+		socket->ptr<uv_stream_t>()->write_queue_size == 0;
+}
+
+
+bool FormWriter::complete() const
+{
+	return _complete;
+}
+
+
+bool FormWriter::cancelled() const
+{
+	return _cancelled;
+}
+
+
+
+//
+// File Part Source
+//
+
+	
+FormPart::FormPart(const std::string& contentType) :	
+	_contentType(contentType),
+	_initialWrite(true)
+{
+}
+
+
+FormPart::~FormPart()
+{
+}
+
+
+NVCollection& FormPart::headers()
+{
+	return _headers;
+}
+
+
+const std::string& FormPart::contentType() const
+{	
+	return _contentType; 
+}
+		
+
+bool FormPart::initialWrite() const
+{
+	return _initialWrite; 
+}
+
+		
+void FormPart::reset()
+{
+	_initialWrite = true; 
+}
+
+
+
+//
+// File Part Source
+//
+
+	
+struct FilePart::File
+	/// Shared file descriptor which outlives pending requests.
+{
+	uv_file fd;
+
+	File(uv_file fd) : fd(fd) {}
+	~File()
+	{
+		uv_fs_t req;
+		uv_fs_close(uv_default_loop(), &req, fd, nullptr);
+		uv_fs_req_cleanup(&req);
+	}
+};
+
+
+struct FilePart::ReadRequest
+{
+	uv_fs_t req;
+	FilePart* part; // nullptr once orphaned
+	std::shared_ptr<File> file;
+	std::vector<char> data;
+	std::size_t size;
+	ssize_t result;
+	enum State { Free, Reading, Ready } state;
+
+	ReadRequest(FilePart* part) : 
+		part(part), file(part->_file), data(FILE_CHUNK_SIZE), 
+		size(0), result(0), state(Free) {}
+};
+
+
+struct FilePart::SendRequest
+{
+	uv_fs_t req;
+	FilePart* part; // nullptr once orphaned
+	std::shared_ptr<File> file;
+	std::size_t size;
+	ssize_t result;
+	bool complete;
+
+	SendRequest(FilePart* part) : 
+		part(part), file(part->_file), size(0), result(0), complete(false) {}
+};
+
+	
+FilePart::FilePart(const std::string& path) :	
+	_path(path),
+	_filename(fs::filename(path)),
+	_fileSize(0),
+	_send(nullptr),
+	_poll(nullptr),
+	_pollFd(-1),
+	_writeWait(false),
+	_readOffset(0),
+	_emitOffset(0),
+	_readIndex(0),
+	_emitIndex(0),
+	_sendFile(false),
+	_writer(nullptr)
+{
+	_reads[0] = _reads[1] = nullptr;
+	open();
+}
+
+
+FilePart::FilePart(const std::string& path, const std::string& contentType) :
+	FormPart(contentType),
+	_path(path),
+	_filename(fs::filename(path)),
+	_fileSize(0),
+	_send(nullptr),
+	_poll(nullptr),
+	_pollFd(-1),
+	_writeWait(false),
+	_readOffset(0),
+	_emitOffset(0),
+	_readIndex(0),
+	_emitIndex(0),
+	_sendFile(false),
+	_writer(nullptr)
+{
+	_reads[0] = _reads[1] = nullptr;
+	open();
+}
+
+
+FilePart::FilePart(const std::string& path, const std::string& filename, const std::string& contentType) :
+	FormPart(contentType),
+	_path(path),
+	_filename(filename),
+	_fileSize(0),
+	_send(nullptr),
+	_poll(nullptr),
+	_pollFd(-1),
+	_writeWait(false),
+	_readOffset(0),
+	_emitOffset(0),
+	_readIndex(0),
+	_emitIndex(0),
+	_sendFile(false),
+	_writer(nullptr)
+{
+	_reads[0] = _reads[1] = nullptr;
+	open();
+}
+
+
+FilePart::~FilePart()
+{
+	cancelRequests();
+	closePoll();
+}
+
+
+void FilePart::open()
+{
+	TraceLS(this) << "Open: " << _path << std::endl;
+
+	// Open a descriptor for threadpool reads
+	uv_fs_t req;
+	int fd = uv_fs_open(uv_default_loop(), &req, _path.c_str(), O_RDONLY, 0, nullptr);
+	uv_fs_req_cleanup(&req);
+	if (fd < 0)
+		throw std::runtime_error("Cannot open file: " + _path);
+	_file = std::make_shared<File>(fd);
+
+	// Get file size
+	int r = uv_fs_fstat(uv_default_loop(), &req, fd, nullptr);
+	_fileSize = req.statbuf.st_size;
+	uv_fs_req_cleanup(&req);
+	if (r < 0)
+		throw std::runtime_error("Cannot open file: " + _path);
+}
+
+
+void FilePart::reset()
+{
+	FormPart::reset();
+	cancelRequests();
+	closePoll();
+	_readOffset = 0;
+	_emitOffset = 0;
+	_readIndex = 0;
+	_emitIndex = 0;
+}
+
+
+void FilePart::cancelRequests()
+{
+	// Pending requests delete themselves on completion
+	for (int i = 0; i < 2; i++) {
+		if (_reads[i]) {
+			if (_reads[i]->state == ReadRequest::Reading)
+				_reads[i]->part = nullptr;
+			else
+				delete _reads[i];
+			_reads[i] = nullptr;
+		}
+	}
+	if (_send) {
+		if (!_send->complete)
+			_send->part = nullptr;
+		else
+			delete _send;
+		_send = nullptr;
+	}
+}
+
+
+void FilePart::setSendFile(bool flag)
+{
+	_sendFile = flag;
+}
+
+
+bool FilePart::writeChunk(FormWriter& writer)
+{
+	TraceLS(this) << "Write chunk" << std::endl;		
+	assert(!writer.cancelled());
+	_initialWrite = false;
+	_writer = &writer;
+
+#ifndef _WIN32
+	// Zero-copy uploads only work when the file bytes go to 
+	// the wire unmodified.
+	if (_sendFile && !writer.connection().request().isChunkedTransferEncoding() &&
+		!dynamic_cast<net::SSLSocket*>(writer.connection().socket().get()) &&
+		dynamic_cast<net::TCPSocket*>(writer.connection().socket().get()))
+		return sendFile(writer);
+#endif
+
+	if (_emitOffset >= _fileSize)
+		return false; // all done
+
+	// Emit the next buffer in file order once it has been read
+	auto req = _reads[_emitIndex];
+	if (req && req->state == ReadRequest::Ready) {
+		if (req->result < 0 || (std::size_t)req->result != req->size)
+			throw std::runtime_error("Cannot read multipart source file: " + _filename);
+
+		writer.emit(req->data.data(), req->size);
+		writer.updateProgress((int)req->size);
+		_emitOffset += req->size;
+		req->state = ReadRequest::Free;
+		_emitIndex ^= 1;
+		if (_emitOffset >= _fileSize)
+			return false; // all done
+	}
+
+	prefetch(writer);
+	return true;
+}
+
+
+void FilePart::prefetch(FormWriter& writer)
+{
+	// Buffers are only refilled once the socket has flushed 
+	// everything we emitted from them.
+	if (!writer.writable())
+		return;
+
+	uv::Loop* loop = writer.connection().socket()->loop();
+	for (int i = 0; i < 2 && _readOffset < _fileSize; i++) {
+		auto& req = _reads[_readIndex];
+		if (!req) 
+			req = new ReadRequest(this);
+		if (req->state != ReadRequest::Free)
+			break;
+
+		req->size = (std::size_t)std::min<UInt64>(FILE_CHUNK_SIZE, _fileSize - _readOffset);
+		req->state = ReadRequest::Reading;
+		req->req.data = req;
+		uv_buf_t buf = uv_buf_init(req->data.data(), req->size);
+		int r = uv_fs_read(loop, &req->req, req->file->fd, &buf, 1, _readOffset, [](uv_fs_t* handle) {
+			auto req = reinterpret_cast<ReadRequest*>(handle->data);
+			req->result = handle->result;
+			uv_fs_req_cleanup(handle);
+			if (!req->part) {
+				delete req; // orphaned
+				return;
+			}
+			req->state = ReadRequest::Ready;
+			req->part->_writer->writeAsync(); // may delete the part
+		});
+		if (r < 0) {
+			req->state = ReadRequest::Free;
+			throw std::runtime_error("Cannot read multipart source file: " + _filename);
+		}
+
+		_readOffset += req->size;
+		_readIndex ^= 1;
+	}
+}
+
+
+bool FilePart::sendFile(FormWriter& writer)
+{
+#ifndef _WIN32
+	if (_send) {
+		if (!_send->complete)
+			return true; // still sending
+
+		if (_send->result < 0 && _send->result != UV_EAGAIN)
+			throw std::runtime_error("Cannot send multipart source file: " + _filename);
+		if (_send->result > 0) {
+			_emitOffset += _send->result;
+			writer.updateProgress((int)_send->result);
+		}
+
+		// EAGAIN or a short send means the socket buffer is full, 
+		// so wait for it to drain before sending again
+		bool full = _send->result == UV_EAGAIN || 
+			(_send->result >= 0 && (std::size_t)_send->result < _send->size);
+		delete _send;
+		_send = nullptr;
+		if (full && _emitOffset < _fileSize)
+			waitWritable(writer);
+	}
+
+	if (_emitOffset >= _fileSize)
+		return false; // all done
+
+	if (_writeWait)
+		return true; // socket buffer still full
+
+	// The part header must reach the socket before the file data
+	if (!writer.writable())
+		return true;
+
+	auto socket = dynamic_cast<net::TCPSocket*>(writer.connection().socket().get());
+	_send = new SendRequest(this);
+	_send->req.data = _send;
+	_send->size = (std::size_t)(_fileSize - _emitOffset);
+	int r = uv_fs_sendfile(socket->loop(), &_send->req, 
+		socket->ptr<uv_tcp_t>()->io_watcher.fd, _send->file->fd, 
+		_emitOffset, _send->size, [](uv_fs_t* handle) {
+		auto req = reinterpret_cast<SendRequest*>(handle->data);
+		req->result = handle->result;
+		uv_fs_req_cleanup(handle);
+		if (!req->part) {
+			delete req; // orphaned
+			return;
+		}
+		req->complete = true;
+		req->part->_writer->writeAsync(); // may delete the part
+	});
+	if (r < 0) {
+		delete _send;
+		_send = nullptr;
+		throw std::runtime_error("Cannot send multipart source file: " + _filename);
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+void FilePart::waitWritable(FormWriter& writer)
+{
+#ifndef _WIN32
+	// The socket's own handle is already registered with the loop, 
+	// so poll a duplicate of its descriptor.
+	if (!_poll) {
+		auto socket = dynamic_cast<net::TCPSocket*>(writer.connection().socket().get());
+		_pollFd = fcntl(socket->ptr<uv_tcp_t>()->io_watcher.fd, F_DUPFD_CLOEXEC, 0);
+		if (_pollFd < 0)
+			throw std::runtime_error("Cannot poll multipart upload socket");
+		_poll = new uv::Handle(socket->loop(), new uv_poll_t);
+		_poll->ptr()->data = this;
+		uv_poll_init(socket->loop(), _poll->ptr<uv_poll_t>(), _pollFd);
+	}
+
+	_writeWait = true;
+	uv_poll_start(_poll->ptr<uv_poll_t>(), UV_WRITABLE, [](uv_poll_t* handle, int, int) {
+		auto part = reinterpret_cast<FilePart*>(handle->data);
+		part->_writeWait = false;
+		uv_poll_stop(handle);
+		part->_writer->writeAsync(); // may delete the part
+	});
+#endif
+}
+
+
+void FilePart::closePoll()
+{
+#ifndef _WIN32
+	if (_poll) {
+#if __linux__
+		// The original descriptor keeps the socket open, so remove
+		// the duplicate from epoll explicitly before closing it
+		struct epoll_event e;
+		epoll_ctl(uv_backend_fd(_poll->loop()), EPOLL_CTL_DEL, _pollFd, &e);
+#endif
+		delete _poll;
+		_poll = nullptr;
+		::close(_pollFd);
+		_pollFd = -1;
+	}
+	_writeWait = false;
+#endif
+}
+
+
+int FilePart::readFile(char* data, std::size_t size, UInt64 offset)
+{
+	uv_fs_t req;
+	uv_buf_t buf = uv_buf_init(data, size);
+	int r = uv_fs_read(uv_default_loop(), &req, _file->fd, &buf, 1, offset, nullptr);
+	uv_fs_req_cleanup(&req);
+	if (r < 0)
+		throw std::runtime_error("Cannot read multipart source file: " + _filename);
+	return r;
+}
+
+
+void FilePart::write(FormWriter& writer)
+{
+	TraceLS(this) << "Write" << std::endl;
+	_initialWrite = false;
+
+	char buffer[FILE_CHUNK_SIZE];
+	UInt64 offset = 0;
+	int n;
+	while (!writer.cancelled() && (n = readFile(buffer, FILE_CHUNK_SIZE, offset)) > 0) {
+		writer.emit(buffer, n);
+		writer.updateProgress(n);
+		offset += n;
+	}
+}
+
+
+void FilePart::write(std::ostream& ostr)
+{
+	TraceLS(this) << "Write" << std::endl;
+	_initialWrite = false;
+	
+	char buffer[FILE_CHUNK_SIZE];
+	UInt64 offset = 0;
+	int n;
+	while ((n = readFile(buffer, FILE_CHUNK_SIZE, offset)) > 0) {
+		ostr.write(buffer, n);
+		offset += n;
+	}
+}
+
+
+const std::string& FilePart::filename() const
+{
+	return _filename;
+}
+
+
+std::ifstream& FilePart::stream()
+{
+	if (!_istr.is_open())
+		_istr.open(_path.c_str(), std::ios::in | std::ios::binary);
+	return _istr;
+}
+
+
+UInt64 FilePart::length() const
+{	
+	return _fileSize; 
+}
+
+
+
+//
+// String Part Source
+//
+
+	
+StringPart::StringPart(const std::string& data) :	
+	FormPart("application/octet-stream"),
+	_data(data)
+{
+}
+
+
+StringPart::StringPart(const std::string& data, const std::string& contentType) :
+	FormPart(contentType),
+	_data(data)
+{
+}
+
+
+StringPart::~StringPart()
+{
+}
+
+
+bool StringPart::writeChunk(FormWriter& writer)
+{
+	TraceLS(this) << "Write chunk" << std::endl;	
+	_initialWrite = false;
+
+	// TODO: Honour chunk size for large strings
+	
+	writer.emit(_data.c_str(), _data.length());
+	writer.updateProgress((int)_data.length());
+
+	return false;
+}
+
+
+void StringPart::write(FormWriter& writer)
+{
+	TraceLS(this) << "Write" << std::endl;
+	_initialWrite = false;
+	
+	writer.emit(_data.c_str(), _data.length());
+	writer.updateProgress((int)_data.length());
+}
+
+
+void StringPart::write(std::ostream& ostr)
+{
+	TraceLS(this) << "Write" << std::endl;
+	_initialWrite = false;
+	
+	ostr.write(_data.c_str(), _data.length());
+}
+	
+
+UInt64 StringPart::length() const
+{	
+	return _data.length(); 
+}
+
+
+} } // namespace scy::http
+
+
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+
+
+
+/*
+void FormWriter::run()
+{
+	prepareSubmit(_connection.request());
+	if (_encoding == ENCODING_URL) {
+		std::ostringstream ostr;
+		writeUrl(ostr);		
+		emit(ostr.str());
+	} else
+		writeMultipart();
+}
+*/
+
+
+/*
+void FormWriter::onIdle()
+{
+	TraceLS(this) << "On idle" << std::endl;
+
+	if (_initial)
+		prepareSubmit(_connection.request());
+	
+	if (_encoding == ENCODING_URL) {
+		std::ostringstream ostr;
+		writeUrl(ostr);		
+		emit(ostr.str());
+		stop(); // all done
+	} 
+	else {
+		writeMultipart();
+		if (_parts.empty())
+			stop(); // all done
+	}
+	
+	_initial = false;
+}
+*/
+
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
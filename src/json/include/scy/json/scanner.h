@@ -0,0 +1,122 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#ifndef SCY_JSON_Scanner_H
+#define SCY_JSON_Scanner_H
+
+
+#include "scy/types.h"
+#include <string>
+#include <cstring>
+
+
+namespace scy {
+namespace json {
+
+
+class Scanner
+	// A forward-only, zero-copy JSON reader which walks the members of
+	// a top-level object without building a DOM.
+	//
+	// Member keys and values point into the input buffer, so the buffer
+	// must outlive the scanner. Nested objects and arrays are skipped
+	// without being decoded; their raw span can be passed to json::Reader
+	// if the value is needed.
+{
+public:
+	enum Kind 
+	{
+		Null,
+		Boolean,
+		Number,
+		String,
+		Object,
+		Array
+	};
+
+	struct Member
+	{
+		const char* key;			// The key, excluding quotes
+		std::size_t keyLength;
+		const char* value;			// The raw value, excluding quotes for strings
+		std::size_t valueLength;
+		Kind kind;
+		bool escaped;				// True if the string value contains escape sequences
+
+		bool is(const char* name) const 
+			// Returns true if the member key matches the given name.
+		{
+			return std::strlen(name) == keyLength && 
+				std::memcmp(key, name, keyLength) == 0;
+		}
+
+		bool isTrue() const
+		{
+			return kind == Boolean && value[0] == 't';
+		}
+
+		bool equals(const char* str) const 
+			// Returns true if the member is an unescaped string
+			// equal to the given string.
+		{
+			return kind == String && !escaped && 
+				std::strlen(str) == valueLength && 
+				std::memcmp(value, str, valueLength) == 0;
+		}
+
+		std::string asString() const;
+			// Returns the value with escape sequences decoded for strings,
+			// or the raw value for other kinds.
+	};
+
+	Scanner(const char* data, std::size_t size);
+	
+	bool next(Member& member);
+		// Reads the next member of the top-level object.
+		// Returns false once the object ends or if the input is
+		// malformed, in which case error() returns true.
+
+	bool error() const;
+		// Returns true if the input is not a valid JSON object.
+
+protected:
+	bool fail();
+	bool skipWhitespace();
+	bool scanString(const char*& begin, std::size_t& length, bool& escaped);
+	bool scanValue(Member& member);
+
+	enum State
+	{
+		Start,
+		Members,
+		Done,
+		Error
+	};
+
+	const char* _pos;
+	const char* _end;
+	State _state;
+};
+
+
+} } // namespace scy::json
+
+
+#endif // SCY_JSON_Scanner_H
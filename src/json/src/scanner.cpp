@@ -0,0 +1,292 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#include "scy/json/scanner.h"
+
+
+namespace scy {
+namespace json {
+
+
+Scanner::Scanner(const char* data, std::size_t size) :
+	_pos(data),
+	_end(data + size),
+	_state(Start)
+{
+}
+
+
+bool Scanner::next(Member& member)
+{
+	switch (_state) {
+	case Start:
+		if (!skipWhitespace() || *_pos != '{')
+			return fail();
+		_pos++;
+		if (!skipWhitespace())
+			return fail();
+		if (*_pos == '}') {
+			_pos++;
+			_state = Done;
+			return false;
+		}
+		_state = Members;
+		break;
+
+	case Members:
+		if (!skipWhitespace())
+			return fail();
+		if (*_pos == '}') {
+			_pos++;
+			_state = Done;
+			return false;
+		}
+		if (*_pos != ',')
+			return fail();
+		_pos++;
+		if (!skipWhitespace())
+			return fail();
+		break;
+
+	case Done:
+	case Error:
+		return false;
+	}
+
+	bool escaped;
+	if (*_pos != '"' || 
+		!scanString(member.key, member.keyLength, escaped) ||
+		!skipWhitespace() || *_pos != ':')
+		return fail();
+	_pos++;
+	if (!skipWhitespace() || !scanValue(member))
+		return fail();
+	return true;
+}
+
+
+bool Scanner::error() const
+{
+	return _state == Error;
+}
+
+
+bool Scanner::fail()
+{
+	_state = Error;
+	return false;
+}
+
+
+bool Scanner::skipWhitespace()
+{
+	while (_pos < _end && 
+		(*_pos == ' ' || *_pos == '\t' || *_pos == '\n' || *_pos == '\r'))
+		_pos++;
+	return _pos < _end;
+}
+
+
+bool Scanner::scanString(const char*& begin, std::size_t& length, bool& escaped)
+{
+	// Expects the opening quote at the current position
+	begin = ++_pos;
+	escaped = false;
+	while (_pos < _end) {
+		char c = *_pos;
+		if (c == '"') {
+			length = _pos - begin;
+			_pos++;
+			return true;
+		}
+		if (c == '\\') {
+			escaped = true;
+			_pos++;
+		}
+		else if (static_cast<unsigned char>(c) < 0x20)
+			return false;
+		_pos++;
+	}
+	return false;
+}
+
+
+bool Scanner::scanValue(Member& member)
+{
+	member.escaped = false;
+	const char* begin = _pos;
+	switch (*_pos) {
+	case '"':
+		member.kind = String;
+		return scanString(member.value, member.valueLength, member.escaped);
+
+	case '{':
+	case '[':
+		{
+			// Skip to the matching bracket, stepping over strings
+			// so brackets inside them are not counted.
+			member.kind = *_pos == '{' ? Object : Array;
+			int depth = 0;
+			const char* str;
+			std::size_t len;
+			bool esc;
+			while (_pos < _end) {
+				char c = *_pos;
+				if (c == '"') {
+					if (!scanString(str, len, esc))
+						return false;
+					continue;
+				}
+				if (c == '{' || c == '[')
+					depth++;
+				else if ((c == '}' || c == ']') && --depth == 0) {
+					_pos++;
+					member.value = begin;
+					member.valueLength = _pos - begin;
+					return true;
+				}
+				_pos++;
+			}
+			return false;
+		}
+
+	case 't':
+	case 'f':
+	case 'n':
+		{
+			const char* literal = *_pos == 't' ? "true" : *_pos == 'f' ? "false" : "null";
+			std::size_t len = std::strlen(literal);
+			if (static_cast<std::size_t>(_end - _pos) < len || 
+				std::memcmp(_pos, literal, len) != 0)
+				return false;
+			member.kind = *_pos == 'n' ? Null : Boolean;
+			member.value = begin;
+			member.valueLength = len;
+			_pos += len;
+			return true;
+		}
+
+	default:
+		while (_pos < _end && 
+			((*_pos >= '0' && *_pos <= '9') || *_pos == '-' || 
+			*_pos == '+' || *_pos == '.' || *_pos == 'e' || *_pos == 'E'))
+			_pos++;
+		if (_pos == begin)
+			return false;
+		member.kind = Number;
+		member.value = begin;
+		member.valueLength = _pos - begin;
+		return true;
+	}
+}
+
+
+namespace internal {
+
+	void appendUTF8(std::string& out, UInt32 cp)
+	{
+		if (cp < 0x80)
+			out += static_cast<char>(cp);
+		else if (cp < 0x800) {
+			out += static_cast<char>(0xC0 | (cp >> 6));
+			out += static_cast<char>(0x80 | (cp & 0x3F));
+		}
+		else if (cp < 0x10000) {
+			out += static_cast<char>(0xE0 | (cp >> 12));
+			out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+			out += static_cast<char>(0x80 | (cp & 0x3F));
+		}
+		else {
+			out += static_cast<char>(0xF0 | (cp >> 18));
+			out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+			out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+			out += static_cast<char>(0x80 | (cp & 0x3F));
+		}
+	}
+
+	bool readHex4(const char*& pos, const char* end, UInt32& cp)
+	{
+		if (end - pos < 4)
+			return false;
+		cp = 0;
+		for (int i = 0; i < 4; i++, pos++) {
+			char c = *pos;
+			cp <<= 4;
+			if (c >= '0' && c <= '9') cp |= c - '0';
+			else if (c >= 'a' && c <= 'f') cp |= c - 'a' + 10;
+			else if (c >= 'A' && c <= 'F') cp |= c - 'A' + 10;
+			else return false;
+		}
+		return true;
+	}
+
+} // namespace internal
+
+
+std::string Scanner::Member::asString() const
+{
+	if (!escaped)
+		return std::string(value, valueLength);
+
+	std::string out;
+	out.reserve(valueLength);
+	const char* pos = value;
+	const char* end = value + valueLength;
+	while (pos < end) {
+		char c = *pos++;
+		if (c != '\\' || pos == end) {
+			out += c;
+			continue;
+		}
+		c = *pos++;
+		switch (c) {
+		case 'b': out += '\b'; break;
+		case 'f': out += '\f'; break;
+		case 'n': out += '\n'; break;
+		case 'r': out += '\r'; break;
+		case 't': out += '\t'; break;
+		case 'u':
+			{
+				UInt32 cp;
+				if (!internal::readHex4(pos, end, cp))
+					return out;
+
+				// Combine UTF-16 surrogate pairs
+				if (cp >= 0xD800 && cp <= 0xDBFF && 
+					end - pos >= 6 && pos[0] == '\\' && pos[1] == 'u') {
+					const char* low = pos + 2;
+					UInt32 cp2;
+					if (internal::readHex4(low, end, cp2) && 
+						cp2 >= 0xDC00 && cp2 <= 0xDFFF) {
+						cp = 0x10000 + ((cp - 0xD800) << 10) + (cp2 - 0xDC00);
+						pos = low;
+					}
+				}
+				internal::appendUTF8(out, cp);
+			}
+			break;
+		default: out += c; break; // quote, backslash and solidus
+		}
+	}
+	return out;
+}
+
+
+} } // namespace scy::json
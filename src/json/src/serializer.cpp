@@ -0,0 +1,217 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#include "scy/json/json.h"
+
+#include <cstring>
+#include <cstdio>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace scy {
+namespace json {
+
+
+namespace internal {
+
+	template<class Output>
+	inline void append(Output& out, const char* data, std::size_t len)
+	{
+		out.insert(out.end(), data, data + len);
+	}
+
+	inline bool needsEscape(unsigned char c)
+	{
+		return c < 0x20 || c == '"' || c == '\\';
+	}
+
+	inline const char* findEscape(const char* pos, const char* end)
+		// Returns the first character which must be escaped, or end.
+	{
+#if defined(__SSE2__)
+		const __m128i quote = _mm_set1_epi8('"');
+		const __m128i backslash = _mm_set1_epi8('\\');
+		const __m128i control = _mm_set1_epi8(0x1F);
+		while (end - pos >= 16) {
+			__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+
+			// Unsigned compare for control characters: c <= 0x1F 
+			// exactly when max(c, 0x1F) == 0x1F
+			__m128i mask = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+				_mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control));
+			int bits = _mm_movemask_epi8(mask);
+			if (bits)
+				return pos + __builtin_ctz(bits);
+			pos += 16;
+		}
+#endif
+		while (pos < end && !needsEscape(static_cast<unsigned char>(*pos)))
+			pos++;
+		return pos;
+	}
+
+	template<class Output>
+	void writeEscape(Output& out, char c)
+	{
+		switch (c) {
+		case '"': append(out, "\\\"", 2); break;
+		case '\\': append(out, "\\\\", 2); break;
+		case '\b': append(out, "\\b", 2); break;
+		case '\f': append(out, "\\f", 2); break;
+		case '\n': append(out, "\\n", 2); break;
+		case '\r': append(out, "\\r", 2); break;
+		case '\t': append(out, "\\t", 2); break;
+		default: 
+			{
+				static const char hex[] = "0123456789ABCDEF";
+				char esc[6] = { '\\', 'u', '0', '0', 
+					hex[(c >> 4) & 0xF], hex[c & 0xF] };
+				append(out, esc, 6);
+			}
+			break;
+		}
+	}
+
+	template<class Output>
+	void writeString(Output& out, const char* str, std::size_t len)
+	{
+		const char* end = str + len;
+		const char* run = str;
+		out.push_back('"');
+		for (;;) {
+			const char* pos = findEscape(run, end);
+			append(out, run, pos - run);
+			if (pos == end)
+				break;
+			writeEscape(out, *pos);
+			run = pos + 1;
+		}
+		out.push_back('"');
+	}
+
+	template<class Output>
+	void writeInt(Output& out, UInt64 value, bool negative)
+	{
+		char buf[24];
+		char* pos = buf + sizeof(buf);
+		do {
+			*--pos = static_cast<char>('0' + value % 10);
+			value /= 10;
+		} 
+		while (value);
+		if (negative)
+			*--pos = '-';
+		append(out, pos, buf + sizeof(buf) - pos);
+	}
+
+	template<class Output>
+	void writeValue(Output& out, const json::Value& value)
+	{
+		switch (value.type()) {
+		case Json::nullValue:
+			append(out, "null", 4);
+			break;
+		case Json::intValue:
+			{
+				Json::LargestInt i = value.asLargestInt();
+				writeInt(out, i < 0 ? 0 - static_cast<UInt64>(i) : static_cast<UInt64>(i), i < 0);
+			}
+			break;
+		case Json::uintValue:
+			writeInt(out, value.asLargestUInt(), false);
+			break;
+		case Json::realValue:
+			{
+				// Doubles are rare in our messages, so match jsoncpp's
+				// formatting exactly rather than reimplementing it.
+				std::string str(Json::valueToString(value.asDouble()));
+				append(out, str.data(), str.size());
+			}
+			break;
+		case Json::stringValue:
+			{
+				const char* str = value.asCString();
+				writeString(out, str ? str : "", str ? std::strlen(str) : 0);
+			}
+			break;
+		case Json::booleanValue:
+			if (value.asBool())
+				append(out, "true", 4);
+			else
+				append(out, "false", 5);
+			break;
+		case Json::arrayValue:
+			{
+				out.push_back('[');
+				Json::ArrayIndex size = value.size();
+				for (Json::ArrayIndex index = 0; index < size; ++index) {
+					if (index > 0)
+						out.push_back(',');
+					writeValue(out, value[index]);
+				}
+				out.push_back(']');
+			}
+			break;
+		case Json::objectValue:
+			{
+				// Members are iterated in key order, as FastWriter 
+				// outputs them, without copying the member names.
+				out.push_back('{');
+				auto end = value.end();
+				for (auto it = value.begin(); it != end; ++it) {
+					if (out.back() != '{')
+						out.push_back(',');
+					const char* name = it.memberName();
+					writeString(out, name, std::strlen(name));
+					out.push_back(':');
+					writeValue(out, *it);
+				}
+				out.push_back('}');
+			}
+			break;
+		}
+	}
+
+} // namespace internal
+
+
+void serialize(const json::Value& root, Buffer& output)
+{
+	internal::writeValue(output, root);
+}
+
+
+void serialize(const json::Value& root, std::string& output)
+{
+	internal::writeValue(output, root);
+}
+
+
+void serializeString(const char* str, std::size_t len, Buffer& output)
+{
+	internal::writeString(output, str, len);
+}
+
+
+} } // namespace scy::json
@@ -0,0 +1,319 @@
+#include "scy/base.h"
+#include "scy/logger.h"
+#include "scy/json/json.h"
+#include "scy/json/scanner.h"
+
+#include <assert.h>
+#include <string>
+#include <vector>
+
+
+using namespace std;
+using namespace scy;
+
+
+namespace scy {
+namespace json {
+
+
+class Tests
+{
+public:
+	Tests()
+	{
+		testScannerEscapes();
+		testScannerSurrogatePairs();
+		testScannerNumbers();
+		testScannerContainers();
+		testScannerMalformed();
+		testSerializeStrings();
+		testSerializeNumbers();
+		testSerializeContainers();
+	}
+
+	static std::vector<Scanner::Member> scan(const std::string& doc)
+		// Returns every member of the document, which must be valid.
+	{
+		std::vector<Scanner::Member> members;
+		Scanner scanner(doc.data(), doc.size());
+		Scanner::Member member;
+		while (scanner.next(member))
+			members.push_back(member);
+		assert(!scanner.error());
+		return members;
+	}
+
+	static void assertMatchesReader(const std::string& doc)
+		// Checks every string member decodes the same as json::Reader.
+	{
+		json::Value root;
+		json::Reader reader;
+		bool parsed = reader.parse(doc, root);
+		assert(parsed);
+		std::vector<Scanner::Member> members = scan(doc);
+		assert(members.size() == root.size());
+		for (auto& member : members) {
+			if (member.kind != Scanner::String)
+				continue;
+			std::string key(member.key, member.keyLength);
+			assert(root.isMember(key));
+			assert(member.asString() == root[key].asString());
+		}
+	}
+
+	static void assertMatchesFastWriter(const json::Value& value)
+		// Checks both serialize() overloads append exactly what
+		// json::FastWriter writes, minus its trailing newline.
+	{
+		json::FastWriter writer;
+		std::string expected(writer.write(value));
+		assert(!expected.empty() && expected[expected.size() - 1] == '\n');
+		expected.erase(expected.size() - 1);
+
+		std::string str("prefix");
+		serialize(value, str);
+		assert(str == "prefix" + expected);
+
+		Buffer buf(3, 'x');
+		serialize(value, buf);
+		assert(std::string(buf.begin(), buf.end()) == "xxx" + expected);
+
+		assert(stringify(value) == expected);
+	}
+
+	// ============================================================================
+	// Serializer Tests
+	//
+	void testSerializeStrings()
+	{
+		// Every control character, alone and inside longer runs
+		// so escapes land on both sides of 16 byte boundaries
+		for (int c = 1; c < 0x20; c++) {
+			std::string ctl(1, (char)c);
+			assertMatchesFastWriter(ctl);
+			for (std::size_t offset = 0; offset < 40; offset += 7)
+				assertMatchesFastWriter(std::string(offset, 'a') + ctl + std::string(33 - offset % 33, 'b'));
+		}
+		assertMatchesFastWriter("\x7f");
+
+		// Quotes, backslashes and slashes
+		assertMatchesFastWriter("");
+		assertMatchesFastWriter("\"");
+		assertMatchesFastWriter("say \"hi\" to \\them\\");
+		assertMatchesFastWriter("http://example.com/path/</script>");
+		assertMatchesFastWriter(std::string(31, '"') + std::string(17, '\\'));
+
+		// Multibyte UTF-8 is copied, not escaped
+		assertMatchesFastWriter("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80");
+		assertMatchesFastWriter(std::string(15, 'a') + "\xF0\x9F\x98\x80\n" + std::string(20, '\xE2'));
+
+		// Keys are escaped the same way as values
+		json::Value obj;
+		obj["k\"/\t\xC3\xA9"] = "v\x01";
+		obj[std::string(20, 'k') + "\\"] = std::string(20, 'v') + "\r";
+		assertMatchesFastWriter(obj);
+
+		// serializeString appends the quoted string alone
+		Buffer buf;
+		std::string raw("a\"b\\c/d\x1f");
+		serializeString(raw.data(), raw.size(), buf);
+		assert(std::string(buf.begin(), buf.end()) == stringify(json::Value(raw)));
+	}
+
+	void testSerializeNumbers()
+	{
+		const double doubles[] = { 0.0, -0.0, 0.1, -1.5, 3.25, 1.0 / 3.0, 123456789.125,
+			1e-7, 2.5e-300, 1e21, -1.7976931348623157e308, 4.9e-324 };
+		for (auto d : doubles)
+			assertMatchesFastWriter(d);
+
+		assertMatchesFastWriter(0);
+		assertMatchesFastWriter(-1);
+		assertMatchesFastWriter(json::Value::minInt);
+		assertMatchesFastWriter(json::Value::maxInt);
+		assertMatchesFastWriter(json::Value::maxUInt);
+		assertMatchesFastWriter(json::Value::minInt64);
+		assertMatchesFastWriter(json::Value::maxInt64);
+		assertMatchesFastWriter(json::Value::maxUInt64);
+		assertMatchesFastWriter(true);
+		assertMatchesFastWriter(false);
+		assertMatchesFastWriter(json::Value());
+
+		json::Value arr(Json::arrayValue);
+		for (auto d : doubles)
+			arr.append(d);
+		arr.append(json::Value::maxUInt64);
+		assertMatchesFastWriter(arr);
+	}
+
+	void testSerializeContainers()
+	{
+		assertMatchesFastWriter(json::Value(Json::arrayValue));
+		assertMatchesFastWriter(json::Value(Json::objectValue));
+
+		json::Value root;
+		root["a"] = json::Value(Json::arrayValue);
+		root["o"] = json::Value(Json::objectValue);
+		root["n"][0] = json::Value(Json::arrayValue);
+		root["n"][1] = json::Value(Json::objectValue);
+		root["n"][2][0][0] = json::Value(Json::arrayValue);
+		root["n"][3]["x"]["y"] = json::Value(Json::objectValue);
+		root["m"]["e"] = json::Value();
+		root["m"]["s"] = "/";
+		root["m"]["d"] = 0.5;
+		assertMatchesFastWriter(root);
+
+		// Round trips through the reader
+		json::Value parsed;
+		json::Reader reader;
+		bool ok = reader.parse(stringify(root), parsed);
+		assert(ok);
+		assert(parsed == root);
+		assertMatchesFastWriter(parsed);
+	}
+
+	// ============================================================================
+	// Scanner Tests
+	//
+	void testScannerEscapes()
+	{
+		std::string doc("{\"plain\":\"abc\", \"quote\":\"say \\\"hi\\\"\", "
+			"\"slash\":\"a\\/b\\\\c\", \"ctrl\":\"\\b\\f\\n\\r\\t\", "
+			"\"ascii\":\"\\u0041\\u007e\"}");
+		std::vector<Scanner::Member> members = scan(doc);
+		assert(members.size() == 5);
+
+		// Unescaped strings point straight into the input
+		assert(members[0].is("plain"));
+		assert(!members[0].escaped);
+		assert(members[0].equals("abc"));
+		assert(members[0].value > doc.data() && members[0].value < doc.data() + doc.size());
+
+		// Escaped strings never compare equal without decoding
+		assert(members[1].escaped);
+		assert(!members[1].equals("say \"hi\""));
+		assert(members[1].asString() == "say \"hi\"");
+		assert(members[2].asString() == "a/b\\c");
+		assert(members[3].asString() == "\b\f\n\r\t");
+		assert(members[4].asString() == "A~");
+		assertMatchesReader(doc);
+
+		// Escaped quotes in keys do not end the key
+		members = scan("{\"k\\\"ey\":1}");
+		assert(members.size() == 1);
+		assert(std::string(members[0].key, members[0].keyLength) == "k\\\"ey");
+	}
+
+	void testScannerSurrogatePairs()
+	{
+		std::string doc("{\"e\":\"caf\\u00e9\", \"euro\":\"\\u20AC\", "
+			"\"emoji\":\"\\ud83d\\ude00!\", \"clef\":\"x\\uD834\\uDD1Ey\"}");
+		std::vector<Scanner::Member> members = scan(doc);
+		assert(members.size() == 4);
+		assert(members[0].asString() == "caf\xC3\xA9");
+		assert(members[1].asString() == "\xE2\x82\xAC");
+		assert(members[2].asString() == "\xF0\x9F\x98\x80!");
+		assert(members[3].asString() == "x\xF0\x9D\x84\x9Ey");
+		assertMatchesReader(doc);
+
+		// Raw UTF-8 passes through untouched
+		members = scan("{\"raw\":\"\xF0\x9F\x98\x80\"}");
+		assert(!members[0].escaped);
+		assert(members[0].asString() == "\xF0\x9F\x98\x80");
+	}
+
+	void testScannerNumbers()
+	{
+		std::string doc("{\"zero\":0,\"neg\":-12,\"frac\":3.25,"
+			"\"exp\":-1.5e+10,\"EXP\":2E-3 , \"big\":18446744073709551615}");
+		const char* values[] = { "0", "-12", "3.25", "-1.5e+10", "2E-3", "18446744073709551615" };
+		std::vector<Scanner::Member> members = scan(doc);
+		assert(members.size() == 6);
+		for (int i = 0; i < 6; i++) {
+			assert(members[i].kind == Scanner::Number);
+			assert(members[i].asString() == values[i]);
+		}
+
+		json::Value root;
+		json::Reader reader;
+		reader.parse(doc, root);
+		assert(std::stod(members[2].asString()) == root["frac"].asDouble());
+		assert(std::stod(members[3].asString()) == root["exp"].asDouble());
+	}
+
+	void testScannerContainers()
+	{
+		// Nested values are skipped whole, including brackets
+		// and escaped quotes inside strings
+		std::string doc("{\"o\":{\"a\":\"}]\\\"{\",\"b\":{}}, \"a\":[1,[2,{\"c\":\"]\"}]],"
+			"\"empty\":[], \"t\":true, \"f\":false, \"n\":null}");
+		std::vector<Scanner::Member> members = scan(doc);
+		assert(members.size() == 6);
+		assert(members[0].kind == Scanner::Object);
+		assert(members[0].asString() == "{\"a\":\"}]\\\"{\",\"b\":{}}");
+		assert(members[1].kind == Scanner::Array);
+		assert(members[1].asString() == "[1,[2,{\"c\":\"]\"}]]");
+		assert(members[2].kind == Scanner::Array);
+		assert(members[2].asString() == "[]");
+		assert(members[3].kind == Scanner::Boolean && members[3].isTrue());
+		assert(members[4].kind == Scanner::Boolean && !members[4].isTrue());
+		assert(members[5].kind == Scanner::Null);
+
+		// The raw spans can be handed to the reader
+		json::Value value;
+		json::Reader reader;
+		bool parsed = reader.parse(members[1].value, members[1].value + members[1].valueLength, value);
+		assert(parsed);
+		assert(value[1][1]["c"].asString() == "]");
+
+		// An empty object has no members and is not an error
+		assert(scan(" { } ").empty());
+	}
+
+	void testScannerMalformed()
+	{
+		const char* docs[] = {
+			"",
+			"   ",
+			"[1,2]",
+			"\"str\"",
+			"{",
+			"{\"a\"}",
+			"{\"a\" 1}",
+			"{\"a\":}",
+			"{\"a\":1,}",
+			"{,\"a\":1}",
+			"{\"a\":1 \"b\":2}",
+			"{\"a\":tru}",
+			"{\"a\":nul",
+			"{\"a\":\"unterminated}",
+			"{\"a\":\"trailing backslash\\",
+			"{\"a\":\"ctl\x01\"}",
+			"{\"a\":{\"b\":1}",
+			"{\"a\":[1,2}",
+			"{a:1}"
+		};
+		for (auto doc : docs) {
+			Scanner scanner(doc, std::strlen(doc));
+			Scanner::Member member;
+			while (scanner.next(member))
+				;
+			assert(scanner.error());
+			assert(!scanner.next(member)); // stays failed
+		}
+	}
+};
+
+
+} } // namespace scy::json
+
+
+int main(int argc, char** argv)
+{
+	Logger::instance().add(new ConsoleChannel("Test", LTrace));
+	{
+		json::Tests app;
+	}
+	Logger::destroy();
+	return 0;
+}
@@ -0,0 +1,157 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef SCY_MEDIA_AVEncoder_H
+#define SCY_MEDIA_AVEncoder_H
+
+
+#include "scy/base.h"
+
+#ifdef HAVE_FFMPEG
+
+#include "scy/packetstream.h"
+#include "scy/media/types.h"
+#include "scy/media/ffmpeg.h"
+#include "scy/media/iencoder.h"
+#include "scy/media/videocontext.h"
+#include "scy/media/audiocontext.h"
+#include "scy/mutex.h"
+#include "scy/queue.h"
+#include <fstream>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/fifo.h>
+#include <libswscale/swscale.h>
+}
+
+
+namespace scy {
+namespace av {
+
+
+class AVEncoder: public IEncoder
+	/// This class implements an multiplex audio/video   
+	/// encoder which depends on libavcodec/libavformat.
+{
+public:
+	struct Stats
+		/// Per-stage timing statistics for pipelined mode.
+	{
+		StageStats convert;
+		StageStats encode;
+		VideoFramePool::Stats frames;	// Pipeline frame pool usage
+	};
+
+	AVEncoder(const EncoderOptions& options);
+	AVEncoder();
+	virtual ~AVEncoder();
+
+	virtual void initialize();
+	virtual void uninitialize();
+	virtual void cleanup();
+
+	virtual void createVideo();
+	virtual void freeVideo();
+	virtual bool encodeVideo(unsigned char* buffer, int bufferSize, int width, int height, UInt64 time = 0);
+	
+	virtual void createAudio();
+	virtual void freeAudio();
+	virtual bool encodeAudio(unsigned char* buffer, int bufferSize, UInt64 time = 0);
+		
+	EncoderOptions& options();
+	VideoEncoderContext* video();
+	AudioEncoderContext* audio();
+	Stats stats() const;
+
+	//virtual void* self() { return this;	}
+			
+	PacketSignal emitter;
+	
+protected:
+	struct PipelineFrame
+	{
+		VideoFramePool::Frame frame;
+		Int64 time;		// Capture time from av_gettime()
+		int width;
+		int height;
+	};
+
+	virtual bool writeVideoPacket(AVPacket& opacket, Int64 time);
+		// Stamps and writes an encoded video packet to the output.
+
+	virtual void flushVideo();
+		// Writes any frames buffered by the video encoder.
+		
+	virtual void startPipeline();
+	virtual void stopPipeline();
+	virtual void runVideoConverter();
+	virtual void runVideoEncoder();
+		// Pipelined mode stage entry points.
+		
+	void updateStats(StageStats& stage, UInt64 busy, UInt64 wait);
+
+	//static Mutex _mutex; // Protects avcodec_open/close()
+
+	EncoderOptions _options;
+	AVFormatContext* _formatCtx;
+	Mutex			_writeMutex;	// Serializes muxer writes between stages
+	mutable Mutex	_statsMutex;
+	Stats			_stats;
+	//clock_t			_startTime;
+	AVIOContext*	_ioCtx;
+	unsigned char*  _ioBuffer; 
+	int				_ioBufferSize; 
+
+	//
+ 	// Video
+	//
+	VideoEncoderContext* _video;
+	//PTSCalculator* _videoPtsCalc;
+	//bool _realtime;
+	//Int64 _videoPts;
+	//Int64 _lastVideoPTS;
+	//UInt64 _lastVideoTime;
+	double _videoPtsRemainder;
+	Thread _convertThread;
+	Thread _encodeThread;
+	BlockingQueue<PipelineFrame> _convertQueue;
+	BlockingQueue<PipelineFrame> _encodeQueue;
+	//FPSCounter		_videoFPS;
+	//clock_t			_videoTime;
+
+	//
+ 	// Audio
+	//
+	AudioEncoderContext* _audio;
+	AVFifoBuffer*	_audioFifo;		
+	UInt8*			_audioBuffer;
+	//PTSCalculator* _audioPtsCalc;
+	//Int64 _audioPts;
+	//FPSCounter		_audioFPS;
+	//clock_t			_audioTime;	
+};
+
+
+} } // namespace scy::av
+
+
+#endif
+#endif	// SCY_MEDIA_AVEncoder_H
\ No newline at end of file
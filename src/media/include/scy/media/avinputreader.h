@@ -0,0 +1,197 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef SCY_MEDIA_AVInputReader_H
+#define SCY_MEDIA_AVInputReader_H
+
+
+#include "scy/base.h"
+
+#ifdef HAVE_FFMPEG
+
+#include "scy/packetsignal.h"
+#include "scy/interface.h"
+#include "scy/interface.h"
+#include "scy/media/types.h"
+#include "scy/media/ffmpeg.h"
+#include "scy/media/videocontext.h"
+#include "scy/media/audiocontext.h"
+#include "scy/mutex.h"
+#include "scy/queue.h"
+
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#ifdef LIBAVDEVICE_VERSION
+#include <libavdevice/avdevice.h>
+#endif
+}
+
+
+namespace scy {
+namespace av {
+
+
+class AVInputReader: public PacketSignal, public async::Startable, public async::Runnable
+	/// Video capture and file input decoder class with reusable
+	/// code that depends on ffmpeg libavcodec/libavformat.
+{
+public:		
+	struct Options 
+	{			
+		bool disableVideo;
+		bool disableAudio;
+		bool iFramesOnly;			// Process i-frames only (does not restrict audio)
+		int processVideoXFrame;		// Process every Xth video frame
+		int processAudioXFrame;		// Process every Xth audio frame
+		double processVideoXSecs;	// Process video frame every X seconds
+		double processAudioXSecs;	// Process audio frame every X seconds
+		bool seekSampling;			// Seek between processVideoXSecs sample points rather 
+									// than decoding the whole stream (seekable files only)
+		bool pooledFrames;			// Emit video in pooled frames which subscribers may retain
+
+		// Threading
+		int videoThreads;			// Video decoder thread count, 0 for auto
+		int videoThreadType;		// FF_THREAD_FRAME and/or FF_THREAD_SLICE, 0 for codec default
+		bool pipelined;				// Demux and decode on separate threads
+		int pipelineSize;			// Maximum number of packets queued between stages
+
+		// Device Input
+		std::string deviceEngine;	// The device capture engine"
+									//		Windows: vfwcap, dshow
+									//		Linux: v4l(video4linux2 or video4linux), dv1394
+		std::string deviceStandard; // Linux only: 'pal', 'secam' or 'ntsc'.
+
+		Options() {
+			disableVideo = false;
+			disableAudio = false;
+			iFramesOnly = false;
+			processVideoXFrame = 0;
+			processAudioXFrame = 0;
+			processVideoXSecs = 0;
+			processAudioXSecs = 0;
+			seekSampling = false;
+			pooledFrames = false;
+			videoThreads = 1;
+			videoThreadType = 0;
+			pipelined = false;
+			pipelineSize = 32;
+						
+#ifdef WIN32
+			deviceEngine = "vfwcap";
+#else
+			deviceEngine = "v4l";
+			deviceStandard = "ntsc";
+#endif
+		}
+	};
+
+	struct Stats
+		/// Per-stage timing statistics.
+		/// In serial mode both stages run on the reader thread.
+	{
+		StageStats demux;
+		StageStats decode;
+		VideoFramePool::Stats frames;	// Emitted video frame pool usage
+	};
+
+	AVInputReader(const Options& options = Options());
+	virtual ~AVInputReader();
+	
+	virtual void openFile(const std::string& file);
+#ifdef LIBAVDEVICE_VERSION
+	virtual void openDevice(int deviceID, int width = 0, int height = 0, double framerate = 0); 
+	virtual void openDevice(const std::string& device, int width = 0, int height = 0, double framerate = 0);
+#endif
+	virtual void openStream(const char* filename, AVInputFormat* inputFormat, AVDictionary** formatParams);
+	virtual void close();
+	
+	virtual void start();
+	virtual void stop();
+
+	virtual void run();
+
+	virtual void sample(const std::vector<double>& times);
+		// Sampler mode: emits one decoded video frame for each of 
+		// the given timestamps (in seconds) using the open context.
+		// Each sample seeks to the nearest preceding keyframe, and 
+		// decodes forward to the sample point. If iFramesOnly is set 
+		// the keyframe itself is emitted without further decoding.
+		// Samples are emitted in the given order on the calling thread.
+		
+	virtual Options& options();
+	virtual AVFormatContext* formatCtx() const;
+	virtual VideoDecoderContext* video() const;
+	virtual AudioDecoderContext* audio() const;
+	virtual std::string error() const;
+	virtual Stats stats() const;
+
+	NullSignal ReadComplete;
+
+protected:
+	virtual void runPipelined();
+		// Runs the demuxer on the reader thread and the 
+		// decoders on a separate thread.
+
+	virtual void runDecoder();
+		// Decoder stage entry point for pipelined mode.
+
+	virtual void decodePacket(AVPacket& ipacket);
+		// Decodes and emits the given packet, honouring
+		// the frame skipping options.
+
+	virtual void flushDecoders();
+		// Flushes and emits buffered decoder frames.
+
+	virtual void emitVideo(AVPacket& opacket);
+		// Emits a decoded video packet. The picture is copied
+		// into a pooled frame if Options::pooledFrames is set.
+
+	void updateStats(StageStats& stage, UInt64 busy, UInt64 wait);
+
+	virtual bool sampleAt(Int64 target, Int64& position);
+		// Seeks if required and decodes the first video frame at or 
+		// after the target timestamp (in video stream units).
+		// The position is the DTS of the last video packet read, or
+		// AV_NOPTS_VALUE if unknown; it is updated on return.
+
+	mutable Mutex	_mutex;
+	Thread			_thread;
+	Thread			_decodeThread;
+	BlockingQueue<AVPacket*> _packets;
+	bool					_stopping;
+	//std::string				_ifile;	
+	std::string				_error;
+	AVFormatContext*		_formatCtx;	
+	VideoDecoderContext*	_video;
+	AudioDecoderContext*	_audio;
+	Options					_options;
+	Stats					_stats;
+	int						_videoFrames;
+	int						_audioFrames;
+};
+
+
+} } // namespace scy::av
+
+
+#endif
+#endif	// SCY_MEDIA_AVInputReader_H
+
@@ -0,0 +1,96 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#ifndef SCY_MEDIA_FramePool_H
+#define SCY_MEDIA_FramePool_H
+
+
+#include "scy/base.h"
+
+#ifdef HAVE_FFMPEG
+
+#include "scy/mutex.h"
+
+#include <map>
+#include <tuple>
+#include <vector>
+#include <memory>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+
+namespace scy {
+namespace av {
+
+
+class VideoFramePool
+	/// A thread-safe pool of reusable video frames keyed by pixel 
+	/// format and resolution.
+	///
+	/// Frames are handed out as reference counted pointers, and the 
+	/// frame buffer is returned to the pool when the last reference 
+	/// is released. Outstanding frames may safely outlive the pool.
+{
+public:
+	typedef std::shared_ptr<AVFrame> Frame;
+
+	struct Stats
+	{
+		Int64 allocated;	// Number of frames allocated by the pool
+		Int64 reused;		// Number of requests served from the pool
+		Int64 pooled;		// Number of idle frames held by the pool
+		Int64 used;			// Number of frames currently handed out
+
+		Stats() : allocated(0), reused(0), pooled(0), used(0) {};
+
+		double reuseRate() const {
+			return (allocated + reused) ? (double)reused / (allocated + reused) : 0.0;
+		}
+	};
+
+	VideoFramePool(std::size_t limit = 16);
+		// The limit is the maximum number of idle frames kept
+		// for each format and resolution.
+
+	virtual ~VideoFramePool();
+
+	Frame get(::PixelFormat pixelFmt, int width, int height);
+		// Returns a frame with an allocated picture buffer, 
+		// or an empty pointer if allocation fails.
+		// The frame PTS is reset to AV_NOPTS_VALUE.
+
+	void clear();
+		// Frees all idle frames.
+
+	Stats stats() const;
+
+protected:
+	struct Store;
+	std::shared_ptr<Store> _store;
+};
+
+
+} } // namespace scy::av
+
+
+#endif
+#endif // SCY_MEDIA_FramePool_H
@@ -0,0 +1,147 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#ifndef SCY_MEDIA_TranscodeRunner_H
+#define SCY_MEDIA_TranscodeRunner_H
+
+
+#include "scy/base.h"
+
+#ifdef HAVE_FFMPEG
+
+#include "scy/taskrunner.h"
+#include "scy/signal.h"
+#include "scy/mutex.h"
+#include "scy/media/iencoder.h"
+
+#include <string>
+#include <vector>
+
+
+namespace scy {
+namespace av {
+
+
+struct TranscodeJob
+	/// A single input file in a TranscodeRunner batch.
+{
+	enum State 
+	{
+		Pending = 0,
+		Running,
+		Complete,
+		Failed
+	};
+
+	std::string ifile;		// The input file path
+	std::string ofile;		// The output file path
+	State state;
+	std::string error;
+	Int64 frames;			// Number of video frames transcoded
+	double duration;		// Media time transcoded in seconds
+	double elapsed;			// Wall clock time in seconds
+	UInt64 memory;			// Estimated frame memory, 0 until opened
+
+	TranscodeJob(const std::string& ifile = "", const std::string& ofile = "") :
+		ifile(ifile), ofile(ofile), state(Pending), frames(0), 
+		duration(0.0), elapsed(0.0), memory(0) {}
+
+	double fps() const {
+		return elapsed > 0 ? frames / elapsed : 0.0;
+	}
+
+	double realtime() const {
+		// Media seconds transcoded per wall clock second
+		return elapsed > 0 ? duration / elapsed : 0.0;
+	}
+};
+
+
+class TranscodeRunner: public Task
+	/// A TaskRunner task which transcodes a queue of input files, 
+	/// running up to a bounded number of AVInputReader to AVEncoder 
+	/// pipelines concurrently, each on its own thread.
+	///
+	/// A new job is only started while the estimated frame memory of
+	/// all running jobs stays within the memory budget. Job states are 
+	/// persisted to the state file so an interrupted batch resumes 
+	/// where it left off; interrupted jobs are restarted from scratch.
+	///
+	/// The task is cancelled once every job has finished.
+{
+public:
+	struct Options 
+	{
+		int concurrency;		// Maximum concurrent jobs, 0 for the core count
+		UInt64 memoryBudget;	// Maximum estimated frame memory in bytes, 0 for no limit
+		std::string stateFile;	// Progress file path, empty to disable persistence
+		EncoderOptions encoder; // Output format and encoder settings for every job.
+								// The input format and file paths are set per job.
+
+		Options() {
+			concurrency = 0;
+			memoryBudget = 0;
+		}
+	};
+
+	TranscodeRunner(const Options& options = Options());
+
+	void add(const std::string& ifile, const std::string& ofile);
+		// Queues an input file unless a job for it already exists,
+		// which may have been loaded from the state file.
+
+	void stop();
+		// Stops all running jobs and returns them to the pending state.
+
+	std::vector<TranscodeJob> jobs() const;
+	Options& options();
+	
+	Signal<const TranscodeJob&> JobComplete;
+		// Signals when a job completes or fails.
+
+	NullSignal Complete;
+		// Signals when every job has finished.
+
+protected:
+	class Pipeline;
+
+	virtual ~TranscodeRunner();
+
+	virtual void run();
+		// Reaps finished pipelines and starts pending jobs 
+		// while concurrency and memory allow.
+
+	void load();
+	void save();
+		// Read and write the state file.
+
+	mutable Mutex _mutex;
+	Options _options;
+	std::vector<TranscodeJob> _jobs;
+	std::vector<Pipeline*> _pipelines;
+	bool _complete;
+};
+
+
+} } // namespace scy::av
+
+
+#endif
+#endif // SCY_MEDIA_TranscodeRunner_H
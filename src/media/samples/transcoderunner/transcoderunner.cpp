@@ -0,0 +1,97 @@
+#include "scy/application.h"
+#include "scy/filesystem.h"
+#include "scy/platform.h"
+#include "scy/logger.h"
+#include "scy/media/transcoderunner.h"
+
+#include <atomic>
+
+
+using namespace std;
+using namespace scy;
+
+
+//
+// Transcodes every file in a directory to MP4 using 
+// concurrent reader/encoder pipelines. 
+//
+// Progress is saved to the state file, so running the 
+// sample again after an interruption resumes the batch.
+//
+// Usage: transcoderunner --dir <input dir> [--jobs <n>] [--memory <MB>]
+//
+
+
+struct BatchObserver
+{
+	std::atomic<bool> complete;
+
+	BatchObserver() : complete(false) {}
+
+	void onJobComplete(void*, const av::TranscodeJob& job)
+	{
+		if (job.state == av::TranscodeJob::Complete)
+			InfoL << "Transcoded " << job.ifile << ": " 
+				<< job.frames << " frames in " << job.elapsed << "s, "
+				<< job.fps() << " fps, " 
+				<< job.realtime() << "x realtime" << endl;
+		else
+			ErrorL << "Failed " << job.ifile << ": " << job.error << endl;
+	}
+
+	void onComplete(void*)
+	{
+		InfoL << "Batch complete" << endl;
+		complete = true;
+	}
+};
+
+
+int main(int argc, char** argv)
+{
+	Logger::instance().add(new ConsoleChannel("debug", LInfo));
+	{
+		OptionParser optparse(argc, argv, "--");
+		std::string dir = optparse.get("dir");
+		if (dir.empty()) {
+			cerr << "Usage: transcoderunner --dir <input dir> [--jobs <n>] [--memory <MB>]" << endl;
+			return 1;
+		}
+
+		av::TranscodeRunner::Options options;
+		if (optparse.has("jobs"))
+			options.concurrency = util::strtoi<int>(optparse.get("jobs"));
+		if (optparse.has("memory"))
+			options.memoryBudget = util::strtoi<UInt64>(optparse.get("memory")) * 1024 * 1024;
+		options.stateFile = dir + "/transcode.state";
+		options.encoder.oformat = av::Format("MP4", "mp4", 
+			av::VideoCodec("MPEG4", "mpeg4", 640, 480, 25, 48000, 1000000, "yuv420p"),
+			av::AudioCodec("AAC", "aac", 2, 44100, 128000, "s16"));
+		options.encoder.pipelined = true;
+
+		// The runner is owned by the TaskRunner once started
+		BatchObserver observer;
+		av::TranscodeRunner* runner = new av::TranscodeRunner(options);
+		runner->JobComplete += sdelegate(&observer, &BatchObserver::onJobComplete);
+		runner->Complete += sdelegate(&observer, &BatchObserver::onComplete);
+
+		std::vector<std::string> files;
+		fs::readdir(dir, files);
+		for (auto it = files.begin(); it != files.end(); ++it) {
+			std::string ext(fs::extname(*it));
+			if (ext != "mp4" && ext != "avi" && ext != "mkv" && ext != "flv" && ext != "mov")
+				continue;
+			std::string ifile(dir + "/" + *it);
+			if (it->find(".out.") != std::string::npos)
+				continue;
+			runner->add(ifile, ifile.substr(0, ifile.length() - ext.length() - 1) + ".out.mp4");
+		}
+
+		TaskRunner taskRunner;
+		taskRunner.start(runner);
+		while (!observer.complete)
+			scy::sleep(100);
+	}
+	Logger::destroy();
+	return 0;
+}
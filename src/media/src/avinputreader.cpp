@@ -0,0 +1,649 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "scy/media/avinputreader.h"
+
+#ifdef HAVE_FFMPEG
+
+#include "scy/platform.h"
+#include "scy/logger.h"
+
+
+using std::endl;
+
+
+namespace scy {
+namespace av {
+
+
+AVInputReader::AVInputReader(const Options& options)  : 
+	_thread(),
+	_packets(options.pipelineSize),
+	_options(options),
+	_formatCtx(nullptr),
+	_video(nullptr),
+	_audio(nullptr),
+	_stopping(false),
+	_videoFrames(0),
+	_audioFrames(0)
+{		
+	TraceLS(this) << "Create" << endl;
+	initializeFFmpeg();
+}
+
+
+AVInputReader::~AVInputReader() 
+{
+	TraceLS(this) << "Destroy" << endl;
+
+	close();
+	uninitializeFFmpeg();
+}
+
+
+void AVInputReader::openFile(const std::string& file)
+{
+	TraceLS(this) << "Opening: " << file << endl;	
+	openStream(file.c_str(), nullptr, nullptr);
+}
+
+
+#ifdef LIBAVDEVICE_VERSION
+void AVInputReader::openDevice(int deviceID, int width, int height, double framerate)
+{
+	std::string device;
+
+#ifdef WIN32
+	// Only vfwcap supports index based input, 
+	// dshow requires full device name.
+	// TODO: Determine device name for for given 
+	// index using DeviceManager.
+	if (_options.deviceEngine != "vfwcap")
+		throw "Cannot open index based device";
+		
+	// Video capture on windows only through 
+	// Video For Windows driver
+	device = Poco::format("%d", deviceID);
+#else
+	if (_options.deviceEngine == "dv1394") {
+		device = Poco::format("/dev/dv1394/%d", deviceID);
+	} 
+	else {
+		device = Poco::format("/dev/video%d", deviceID);
+	}
+#endif
+
+	openDevice(device, width, height, framerate);
+}
+
+
+void AVInputReader::openDevice(const std::string& device, int width, int height, double framerate) //int deviceID, 
+{        
+	TraceLS(this) << "Opening Device: " << device << endl;	
+
+	avdevice_register_all();
+
+	AVInputFormat* iformat;
+	AVDictionary*  iparams = nullptr;
+        
+#ifdef WIN32
+    iformat = av_find_input_format(_options.deviceEngine.c_str());
+#else
+	if (_options.deviceEngine == "dv1394") {
+        iformat = av_find_input_format("dv1394");
+	} 
+	else {
+		const char* formats[] = {"video4linux2,v4l2", "video4linux2", "video4linux"};
+		int i, formatsCount = sizeof(formats) / sizeof(char*);
+		for (i = 0; i < formatsCount; i++) {
+			iformat = av_find_input_format(formats[i]);
+			if (iformat)
+				break;
+		}
+	}	
+#endif
+	
+    if (!iformat)
+		throw std::runtime_error("Couldn't find input format.");
+	
+	// frame rate
+	if (framerate)
+		av_dict_set(&iparams, "framerate", Poco::format("%f", framerate).c_str(), 0);
+	
+	// video size
+	if (width && height)
+		av_dict_set(&iparams, "video_size", Poco::format("%dx%d", width, height).c_str(), 0);
+	
+	// video standard
+	if (!_options.deviceStandard.empty())
+		av_dict_set(&iparams, "standard", _options.deviceStandard.c_str(), 0);
+
+	openStream(device.c_str(), iformat, &iparams);
+	
+	// for video capture it is important to do non blocking read
+	//_formatCtx->flags |= AVFMT_FLAG_NONBLOCK;
+
+	av_dict_free(&iparams);
+}
+#endif
+
+
+void AVInputReader::openStream(const char* filename, AVInputFormat* inputFormat, AVDictionary** formatParams)
+{
+	TraceLS(this) << "Opening Stream: " << std::string(filename) << endl;
+	
+	if (avformat_open_input(&_formatCtx, filename, inputFormat, formatParams) != 0)
+		throw std::runtime_error("Cannot open the media source: " + std::string(filename));
+
+	if (av_find_stream_info(_formatCtx) < 0)
+		throw std::runtime_error("Cannot find stream information: " + std::string(filename));
+	
+  	av_dump_format(_formatCtx, 0, filename, 0);
+	
+	for (unsigned i = 0; i < _formatCtx->nb_streams; i++) {
+		if (_formatCtx->streams[i]->codec->codec_type == AVMEDIA_TYPE_VIDEO && 
+			_video == nullptr && !_options.disableVideo) {
+			_video = new VideoDecoderContext();
+			_video->create(_formatCtx, i);
+			_video->threads = _options.videoThreads;
+			if (_options.videoThreadType)
+				_video->threadType = _options.videoThreadType;
+			_video->open();
+		}
+		else if (_formatCtx->streams[i]->codec->codec_type == AVMEDIA_TYPE_AUDIO &&
+			_audio == nullptr && !_options.disableAudio) {
+			_audio = new AudioDecoderContext();
+			_audio->create(_formatCtx, i);
+			_audio->open();
+		}
+	}
+
+	if (_video == nullptr && 
+		_audio == nullptr)
+		throw std::runtime_error("Cannot find a valid media stream: " + std::string(filename));
+}
+
+
+void AVInputReader::close()
+{
+	TraceLS(this) << "Closing" << endl;
+
+	if (_video) {
+		delete _video;
+		_video = nullptr;
+	}
+
+	if (_audio) {
+		delete _audio;
+		_audio = nullptr;
+	}
+
+	if (_formatCtx) {
+  		av_close_input_file(_formatCtx);
+		_formatCtx = nullptr;
+  	}
+
+	TraceLS(this) << "Closing: OK" << endl;
+}
+
+
+void AVInputReader::start() 
+{
+	TraceLS(this) << "Starting" << endl;
+
+	Mutex::ScopedLock lock(_mutex);
+	assert(_video || _audio);
+
+	if (_video || _audio &&
+		!_thread.running()) {
+		TraceLS(this) << "Initializing Thread" << endl;
+		_stopping = false;
+		_thread.start(*this);
+	}
+
+	TraceLS(this) << "Starting: OK" << endl;
+}
+
+
+void AVInputReader::stop() 
+{
+	TraceLS(this) << "Stopping" << endl;
+
+	//Mutex::ScopedLock lock(_mutex);	
+	
+	_stopping = true;
+	if (_thread.running()) {
+		TraceLS(this) << "Terminating Thread" << endl;		
+		_thread.join();
+	}
+
+	TraceLS(this) << "Stopping: OK" << endl;
+}
+
+
+void AVInputReader::run() 
+{
+	TraceLS(this) << "Running" << endl;
+	
+	try {
+		_videoFrames = 0;
+		_audioFrames = 0;
+		{
+			Mutex::ScopedLock lock(_mutex);
+			_stats = Stats();
+		}
+
+		if (_options.seekSampling && _options.processVideoXSecs > 0 && 
+			_video && _formatCtx->duration != AV_NOPTS_VALUE) {
+			std::vector<double> times;
+			double duration = (double)_formatCtx->duration / AV_TIME_BASE;
+			for (double time = 0; time < duration; time += _options.processVideoXSecs)
+				times.push_back(time);
+			sample(times);
+		}
+		else if (_options.pipelined) {
+			runPipelined();
+		}
+		else {
+			int res;
+			AVPacket ipacket;
+			av_init_packet(&ipacket);
+
+			UInt64 start = uv_hrtime();
+			while ((res = av_read_frame(_formatCtx, &ipacket)) >= 0) {
+				UInt64 read = uv_hrtime();
+				updateStats(_stats.demux, read - start, 0);
+				if (_stopping) {
+					av_free_packet(&ipacket);
+					break;
+				}
+				decodePacket(ipacket);
+				av_free_packet(&ipacket);
+				start = uv_hrtime();
+				updateStats(_stats.decode, start - read, 0);
+			}
+			
+			if (!_stopping && res < 0) {
+				flushDecoders();
+
+				// End of file or error.
+				TraceLS(this) << "Decoding: EOF" << endl;
+			}
+		}
+	} 
+	catch (std::exception& exc) {
+		_error = exc.what();
+		ErrorLS(this) << "Decoder Error: " << _error << endl;
+	}
+	catch (...) {
+		_error = "Unknown Error";
+		ErrorLS(this) << "Unknown Error" << endl;
+	}
+
+	TraceLS(this) << "Exiting" << endl;
+	ReadComplete.emit(this);
+}
+
+
+void AVInputReader::sample(const std::vector<double>& times) 
+{
+	TraceLS(this) << "Sampling: " << times.size() << endl;
+
+	if (!_video)
+		throw std::runtime_error("Sampling requires an open video stream.");
+	
+	// Let the demuxer skip everything but video while sampling.
+	std::vector<AVDiscard> discard;
+	for (unsigned i = 0; i < _formatCtx->nb_streams; i++) {
+		discard.push_back(_formatCtx->streams[i]->discard);
+		if (i != (unsigned)_video->stream->index)
+			_formatCtx->streams[i]->discard = AVDISCARD_ALL;
+	}
+
+	try {
+		_stopping = false;
+		AVStream* stream = _video->stream;
+		Int64 position = AV_NOPTS_VALUE;
+		for (auto it = times.begin(); it != times.end() && !_stopping; ++it) {
+			Int64 target = (Int64)(*it / av_q2d(stream->time_base));
+			if (stream->start_time != AV_NOPTS_VALUE)
+				target += stream->start_time;
+			if (!sampleAt(target, position)) {
+				TraceLS(this) << "Sampling: No frame at " << *it << endl;
+				if (position == AV_NOPTS_VALUE)
+					break; // EOF
+			}
+		}
+	} 
+	catch (std::exception& exc) {
+		_error = exc.what();
+		ErrorLS(this) << "Sampler Error: " << _error << endl;
+	}
+
+	for (unsigned i = 0; i < discard.size(); i++)
+		_formatCtx->streams[i]->discard = discard[i];
+
+	TraceLS(this) << "Sampling: OK" << endl;
+}
+
+
+bool AVInputReader::sampleAt(Int64 target, Int64& position) 
+{
+	AVStream* stream = _video->stream;
+
+	// Only seek if the keyframe preceding the target lies beyond the 
+	// current read position, otherwise decoding forward is cheaper.
+	// Without an index we can't tell, so always seek forward jumps.
+	bool seek = position == AV_NOPTS_VALUE || target < position;
+	if (!seek) {
+		int index = av_index_search_timestamp(stream, target, AVSEEK_FLAG_BACKWARD);
+		seek = index < 0 || stream->index_entries[index].timestamp > position;
+	}
+	if (seek) {
+		if (av_seek_frame(_formatCtx, stream->index, target, AVSEEK_FLAG_BACKWARD) < 0)
+			throw std::runtime_error("Cannot seek to sample position.");
+		avcodec_flush_buffers(_video->ctx);
+	}
+	
+	AVPacket ipacket;
+	AVPacket opacket;
+	av_init_packet(&ipacket);
+	bool found = false;
+	while (!found && !_stopping) {
+		if (av_read_frame(_formatCtx, &ipacket) < 0) {
+
+			// End of file: the sample point may still be
+			// buffered inside the decoder.
+			position = AV_NOPTS_VALUE;
+			while (!found && _video->flush(opacket))
+				found = opacket.pts == AV_NOPTS_VALUE || opacket.pts >= target;
+			break;
+		}
+		if (ipacket.stream_index == stream->index) {
+			position = ipacket.dts != AV_NOPTS_VALUE ? ipacket.dts : ipacket.pts;
+			if ((!_options.iFramesOnly || (ipacket.flags & AV_PKT_FLAG_KEY)) &&
+				_video->decode(ipacket, opacket)) {
+				found = _options.iFramesOnly || 
+					opacket.pts == AV_NOPTS_VALUE || opacket.pts >= target;
+			}
+		}
+		av_free_packet(&ipacket);
+	}
+
+	if (found) {
+		emitVideo(opacket);
+	}
+	return found;
+}
+
+
+void AVInputReader::emitVideo(AVPacket& opacket) 
+{
+	AVCodecContext* ctx = _video->ctx;
+	VideoPacket video((char*)opacket.data, opacket.size, ctx->width, ctx->height, _video->pts);
+	video.source = &opacket;
+	if (_options.pooledFrames) {
+
+		// The decoder owns its picture buffer, so copy it 
+		// into a pooled frame which may outlive the emit.
+		video.frame = _video->pool.get(ctx->pix_fmt, ctx->width, ctx->height);
+		if (!video.frame)
+			throw std::runtime_error("Cannot allocate video frame");
+		av_picture_copy(reinterpret_cast<AVPicture*>(video.frame.get()), 
+			reinterpret_cast<const AVPicture*>(_video->frame), ctx->pix_fmt, ctx->width, ctx->height);
+		video.frame->pts = opacket.pts;
+		video.setData((char*)video.frame->data[0], 
+			avpicture_get_size(ctx->pix_fmt, ctx->width, ctx->height));
+	}
+	emit(this, video);
+}
+
+
+void AVInputReader::runPipelined() 
+{
+	TraceLS(this) << "Running pipelined" << endl;
+
+	_packets.reset();
+	_decodeThread.start(std::bind(&AVInputReader::runDecoder, this));
+
+	try {
+		UInt64 start = uv_hrtime();
+		while (!_stopping) {
+			AVPacket* ipacket = new AVPacket;
+			av_init_packet(ipacket);
+			if (av_read_frame(_formatCtx, ipacket) < 0) {
+				delete ipacket;
+				break;
+			}
+
+			// Drop packets for streams we are not decoding
+			// before they cost a copy and a queue slot.
+			if ((!_video || ipacket->stream_index != _video->stream->index) &&
+				(!_audio || ipacket->stream_index != _audio->stream->index)) {
+				av_free_packet(ipacket);
+				delete ipacket;
+				continue;
+			}
+		
+			// Packet data may be owned by the demuxer and is only valid 
+			// until the next read, so the decoder gets a private copy.
+			if (av_dup_packet(ipacket) < 0) {
+				delete ipacket;
+				throw std::runtime_error("Cannot duplicate input packet.");
+			}
+
+			// Blocks while the decoder stage is saturated.
+			UInt64 read = uv_hrtime();
+			bool queued = _packets.push(ipacket);
+			UInt64 end = uv_hrtime();
+			updateStats(_stats.demux, read - start, end - read);
+			start = end;
+			if (!queued) {
+				// The decoder stage has exited
+				av_free_packet(ipacket);
+				delete ipacket;
+				break;
+			}
+		}
+	}
+	catch (...) {
+		// Stop the decoder before unwinding so the
+		// thread is never left blocked on the queue.
+		_packets.close();
+		_decodeThread.join();
+		throw;
+	}
+
+	// Signal end of stream. The decoder will drain
+	// the remaining packets and flush the codecs.
+	_packets.close();
+	_decodeThread.join();
+
+	TraceLS(this) << "Running pipelined: EOF" << endl;
+}
+
+
+void AVInputReader::runDecoder() 
+{
+	TraceLS(this) << "Decoder running" << endl;
+
+	AVPacket* ipacket = nullptr;
+	try {
+		UInt64 start = uv_hrtime();
+		while (_packets.pop(ipacket)) {
+			UInt64 popped = uv_hrtime();
+			if (!_stopping)
+				decodePacket(*ipacket);
+			av_free_packet(ipacket);
+			delete ipacket;
+			ipacket = nullptr;
+			UInt64 end = uv_hrtime();
+			updateStats(_stats.decode, end - popped, popped - start);
+			start = end;
+		}
+
+		if (!_stopping)
+			flushDecoders();
+	}
+	catch (std::exception& exc) {
+		Mutex::ScopedLock lock(_mutex);
+		_error = exc.what();
+		ErrorLS(this) << "Decoder Error: " << _error << endl;
+	}
+
+	// Stop the demuxer if we exited early, and 
+	// release any packets left in the queue.
+	_packets.close();
+	if (ipacket) {
+		av_free_packet(ipacket);
+		delete ipacket;
+	}
+	while (_packets.tryPop(ipacket)) {
+		av_free_packet(ipacket);
+		delete ipacket;
+	}
+
+	TraceLS(this) << "Decoder exiting" << endl;
+}
+
+
+void AVInputReader::decodePacket(AVPacket& ipacket) 
+{
+	AVPacket opacket;
+	if (_video && ipacket.stream_index == _video->stream->index) {
+		if ((!_options.processVideoXFrame || (_videoFrames % _options.processVideoXFrame) == 0) &&
+			(!_options.processVideoXSecs || !_video->pts || ((ipacket.pts * av_q2d(_video->stream->time_base)) - _video->pts) > _options.processVideoXSecs) &&
+			(!_options.iFramesOnly || (ipacket.flags & AV_PKT_FLAG_KEY))) {
+ 			if (_video->decode(ipacket, opacket)) {
+				//TraceLS(this) << "Decoded video: " << _video->pts << endl;
+				emitVideo(opacket);
+			}
+		}
+		//else
+		//	TraceLS(this) << "Skipping video frame: " << _videoFrames << endl;
+		_videoFrames++;
+	}
+	else if (_audio && ipacket.stream_index == _audio->stream->index) {	
+		if ((!_options.processAudioXFrame || (_audioFrames % _options.processAudioXFrame) == 0) &&
+			(!_options.processAudioXSecs || !_audio->pts || ((ipacket.pts * av_q2d(_audio->stream->time_base)) - _audio->pts) > _options.processAudioXSecs)) {
+			if (_audio->decode(ipacket, opacket)) {			
+				//TraceLS(this) << "Decoded Audio: " << _audio->pts << endl;
+				AudioPacket audio((char*)opacket.data, opacket.size, _audio->pts);
+				audio.source = &opacket;
+				emit(this, audio);
+			}	
+		}
+		//else
+		//	TraceLS(this) << "Skipping audio frame: " << _audioFrames << endl;
+		_audioFrames++;
+	} 
+}
+
+
+void AVInputReader::flushDecoders() 
+{
+	bool gotFrame = false;
+				
+	// Flush video
+	while (_video && true) {
+		AVPacket opacket;
+		gotFrame = _video->flush(opacket);
+		if (gotFrame) {
+			emitVideo(opacket);
+		} 					
+		av_free_packet(&opacket);
+		if (!gotFrame)
+			break;
+	}
+				
+	// Flush audio
+	while (_audio && true) {
+		AVPacket opacket;
+		gotFrame = _audio->flush(opacket);
+		if (gotFrame) {
+			AudioPacket audio((char*)opacket.data, opacket.size, _audio->pts);
+			audio.source = &opacket;
+			emit(this, audio);
+		}					
+		av_free_packet(&opacket);
+		if (!gotFrame)
+			break;
+	}
+}
+
+
+void AVInputReader::updateStats(StageStats& stage, UInt64 busy, UInt64 wait)
+{
+	Mutex::ScopedLock lock(_mutex);	
+	stage.update(busy, wait);
+}
+
+
+AVInputReader::Options& AVInputReader::options()
+{ 
+	Mutex::ScopedLock lock(_mutex);
+	return _options; 
+}
+	
+
+AVFormatContext* AVInputReader::formatCtx() const
+{
+	Mutex::ScopedLock lock(_mutex);	
+	return _formatCtx;
+}
+	
+
+VideoDecoderContext* AVInputReader::video() const
+{
+	Mutex::ScopedLock lock(_mutex);	
+	return _video;
+}
+	
+
+AudioDecoderContext* AVInputReader::audio() const
+{
+	Mutex::ScopedLock lock(_mutex);	
+	return _audio;
+}
+
+
+std::string AVInputReader::error() const
+{
+	Mutex::ScopedLock lock(_mutex);	
+	return _error;
+}
+
+
+AVInputReader::Stats AVInputReader::stats() const
+{
+	Stats stats;
+	{
+		Mutex::ScopedLock lock(_mutex);	
+		stats = _stats;
+	}
+	if (_video)
+		stats.frames = _video->pool.stats();
+	return stats;
+}
+
+
+} } // namespace scy::av
+
+
+#endif
\ No newline at end of file
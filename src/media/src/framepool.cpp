@@ -0,0 +1,149 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#include "scy/media/framepool.h"
+
+#ifdef HAVE_FFMPEG
+
+#include "scy/media/videocontext.h"
+#include "scy/logger.h"
+
+
+using std::endl;
+
+
+namespace scy {
+namespace av {
+
+
+struct VideoFramePool::Store
+	/// Pool state shared with the deleters of outstanding frames.
+{
+	typedef std::tuple<int, int, int> Key; // pixel format, width, height
+	typedef std::map<Key, std::vector<AVFrame*>> FrameMap;
+
+	mutable Mutex mutex;
+	FrameMap frames;
+	Stats stats;
+	std::size_t limit;
+	bool closed;
+
+	Store(std::size_t limit) : limit(limit), closed(false) {}
+
+	void release(AVFrame* frame)
+	{
+		{
+			Mutex::ScopedLock lock(mutex);
+			stats.used--;
+			if (!closed) {
+				std::vector<AVFrame*>& idle = frames[Key(frame->format, frame->width, frame->height)];
+				if (idle.size() < limit) {
+					idle.push_back(frame);
+					stats.pooled++;
+					return;
+				}
+			}
+		}
+		freeVideoFrame(frame);
+	}
+
+	void clear()
+	{
+		FrameMap idle;
+		{
+			Mutex::ScopedLock lock(mutex);
+			idle.swap(frames);
+			stats.pooled = 0;
+		}
+		for (auto it = idle.begin(); it != idle.end(); ++it) {
+			for (auto fit = it->second.begin(); fit != it->second.end(); ++fit)
+				freeVideoFrame(*fit);
+		}
+	}
+};
+
+
+VideoFramePool::VideoFramePool(std::size_t limit) : 
+	_store(std::make_shared<Store>(limit))
+{
+}
+
+
+VideoFramePool::~VideoFramePool()
+{
+	// Frames which are still referenced will be 
+	// freed rather than pooled when released.
+	{
+		Mutex::ScopedLock lock(_store->mutex);
+		_store->closed = true;
+	}
+	_store->clear();
+}
+
+
+VideoFramePool::Frame VideoFramePool::get(::PixelFormat pixelFmt, int width, int height)
+{
+	AVFrame* frame = nullptr;
+	{
+		Mutex::ScopedLock lock(_store->mutex);
+		auto it = _store->frames.find(Store::Key(pixelFmt, width, height));
+		if (it != _store->frames.end() && !it->second.empty()) {
+			frame = it->second.back();
+			it->second.pop_back();
+			_store->stats.pooled--;
+			_store->stats.reused++;
+			_store->stats.used++;
+		}
+	}
+
+	if (!frame) {
+		frame = createVideoFrame(pixelFmt, width, height);
+		if (!frame)
+			return Frame();
+		Mutex::ScopedLock lock(_store->mutex);
+		_store->stats.allocated++;
+		_store->stats.used++;
+	}
+	frame->pts = AV_NOPTS_VALUE;
+
+	std::shared_ptr<Store> store(_store);
+	return Frame(frame, [store](AVFrame* frame) {
+		store->release(frame);
+	});
+}
+
+
+void VideoFramePool::clear()
+{
+	_store->clear();
+}
+
+
+VideoFramePool::Stats VideoFramePool::stats() const
+{
+	Mutex::ScopedLock lock(_store->mutex);
+	return _store->stats;
+}
+
+
+} } // namespace scy::av
+
+
+#endif
@@ -0,0 +1,408 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#include "scy/media/transcoderunner.h"
+
+#ifdef HAVE_FFMPEG
+
+#include "scy/media/avinputreader.h"
+#include "scy/media/avencoder.h"
+#include "scy/filesystem.h"
+#include "scy/logger.h"
+#include "scy/util.h"
+
+#include <fstream>
+#include <algorithm>
+
+
+using std::endl;
+
+
+namespace scy {
+namespace av {
+
+
+class TranscodeRunner::Pipeline
+	/// Transcodes a single job on its own thread.
+{
+public:
+	std::size_t index;
+	TranscodeJob job;
+	AVInputReader reader;
+	AVEncoder* encoder;
+	Thread thread;
+
+	Pipeline(std::size_t index, const TranscodeJob& job, const EncoderOptions& eoptions) : 
+		index(index), job(job), encoder(nullptr), _done(false), _stopping(false), 
+		_firstTime(-1.0), _lastTime(0.0)
+	{
+		reader.openFile(job.ifile);
+		
+		// Match the encoder input to the decoded streams
+		EncoderOptions options(eoptions);
+		options.ifile = job.ifile;
+		options.ofile = job.ofile;
+		if (reader.video() && options.oformat.video.enabled) {
+			initVideoCodecFromContext(reader.video()->ctx, options.iformat.video);
+			options.iformat.video.enabled = true;
+		}
+		else
+			options.oformat.video.enabled = false;
+		if (reader.audio() && options.oformat.audio.enabled) {
+			AVCodecContext* ctx = reader.audio()->ctx;
+			options.iformat.audio.channels = ctx->channels;
+			options.iformat.audio.sampleRate = ctx->sample_rate;
+			options.iformat.audio.sampleFmt = av_get_sample_fmt_name(ctx->sample_fmt);
+			options.iformat.audio.enabled = true;
+		}
+		else {
+			options.oformat.audio.enabled = false;
+			reader.options().disableAudio = true;
+		}
+
+		// Frames in flight: the decoder's reference frames and 
+		// threads, the pipeline queues and the conversion buffer.
+		if (reader.video()) {
+			AVCodecContext* ctx = reader.video()->ctx;
+			int frames = 4 + std::max(ctx->thread_count, 1) + ctx->refs;
+			if (options.pipelined)
+				frames += options.pipelineSize * 2;
+			this->job.memory = (UInt64)avpicture_get_size(ctx->pix_fmt, ctx->width, ctx->height) * frames;
+		}
+
+		encoder = new AVEncoder(options);
+		reader += packetDelegate(this, &Pipeline::onVideo);
+		reader += packetDelegate(this, &Pipeline::onAudio);
+	}
+
+	~Pipeline()
+	{
+		reader.detach(this);
+		if (encoder)
+			delete encoder;
+	}
+
+	void start()
+	{
+		thread.start(std::bind(&Pipeline::run, this));
+	}
+
+	void stop()
+	{
+		{
+			Mutex::ScopedLock lock(_mutex);
+			_stopping = true;
+		}
+		reader.stop();
+	}
+
+	bool done() const
+	{
+		Mutex::ScopedLock lock(_mutex);
+		return _done;
+	}
+
+	void run()
+	{
+		UInt64 start = uv_hrtime();
+		TranscodeJob::State state = TranscodeJob::Complete;
+		std::string error;
+		try {
+			encoder->initialize();
+			try {
+				reader.run();
+			}
+			catch (std::exception&) {
+				// Join the encoder threads and close the 
+				// output file before reporting the failure.
+				encoder->uninitialize();
+				throw;
+			}
+			encoder->uninitialize();
+			error = reader.error();
+			if (!error.empty())
+				state = TranscodeJob::Failed;
+		}
+		catch (std::exception& exc) {
+			error = exc.what();
+			state = TranscodeJob::Failed;
+		}
+
+		Mutex::ScopedLock lock(_mutex);
+		if (_stopping)
+			state = TranscodeJob::Pending;
+		job.state = state;
+		job.error = error;
+		job.elapsed = (uv_hrtime() - start) / 1e9;
+		job.duration = _firstTime < 0 ? 0.0 : _lastTime - _firstTime;
+		_done = true;
+	}
+
+	void onVideo(void*, VideoPacket& packet)
+	{
+		encoder->encodeVideo((unsigned char*)packet.data(), packet.size(), packet.width, packet.height);
+
+		Mutex::ScopedLock lock(_mutex);
+		job.frames++;
+		if (_firstTime < 0)
+			_firstTime = packet.time;
+		_lastTime = packet.time;
+	}
+
+	void onAudio(void*, AudioPacket& packet)
+	{
+		encoder->encodeAudio((unsigned char*)packet.data(), packet.size());
+		if (!reader.video()) {
+			Mutex::ScopedLock lock(_mutex);
+			if (_firstTime < 0)
+				_firstTime = packet.time;
+			_lastTime = packet.time;
+		}
+	}
+
+protected:
+	mutable Mutex _mutex;
+	bool _done;
+	bool _stopping;
+	double _firstTime;
+	double _lastTime;
+};
+
+
+TranscodeRunner::TranscodeRunner(const Options& options) : 
+	Task(true),
+	_options(options),
+	_complete(false)
+{
+	TraceLS(this) << "Create" << endl;
+
+	if (_options.concurrency <= 0) {
+		uv_cpu_info_t* cpus;
+		int count;
+		if (uv_cpu_info(&cpus, &count) == 0) {
+			_options.concurrency = count;
+			uv_free_cpu_info(cpus, count);
+		}
+		if (_options.concurrency <= 0)
+			_options.concurrency = 1;
+	}
+
+	load();
+}
+
+
+TranscodeRunner::~TranscodeRunner()
+{
+	TraceLS(this) << "Destroy" << endl;
+	stop();
+}
+
+
+void TranscodeRunner::add(const std::string& ifile, const std::string& ofile)
+{
+	Mutex::ScopedLock lock(_mutex);
+	for (auto it = _jobs.begin(); it != _jobs.end(); ++it) {
+		if (it->ifile == ifile)
+			return;
+	}
+	_jobs.push_back(TranscodeJob(ifile, ofile));
+	_complete = false;
+}
+
+
+void TranscodeRunner::stop()
+{
+	std::vector<Pipeline*> pipelines;
+	{
+		Mutex::ScopedLock lock(_mutex);
+		pipelines.swap(_pipelines);
+	}
+	if (pipelines.empty())
+		return;
+
+	TraceLS(this) << "Stopping: " << pipelines.size() << endl;
+	for (auto it = pipelines.begin(); it != pipelines.end(); ++it)
+		(*it)->stop();
+	for (auto it = pipelines.begin(); it != pipelines.end(); ++it) {
+		(*it)->thread.join();
+		{
+			Mutex::ScopedLock lock(_mutex);
+			_jobs[(*it)->index] = (*it)->job;
+		}
+		delete *it;
+	}
+	save();
+}
+
+
+void TranscodeRunner::run()
+{
+	std::vector<TranscodeJob> finished;
+	bool complete = false;
+	bool changed = false;
+	{
+		Mutex::ScopedLock lock(_mutex);
+
+		// Reap finished pipelines
+		UInt64 memory = 0;
+		for (auto it = _pipelines.begin(); it != _pipelines.end();) {
+			Pipeline* pipeline = *it;
+			if (pipeline->done()) {
+				pipeline->thread.join();
+				_jobs[pipeline->index] = pipeline->job;
+				finished.push_back(pipeline->job);
+				TraceLS(this) << "Job finished: " << pipeline->job.ifile 
+					<< ": " << pipeline->job.fps() << "fps" 
+					<< ": " << pipeline->job.realtime() << "x realtime" << endl;
+				delete pipeline;
+				it = _pipelines.erase(it);
+				changed = true;
+			}
+			else {
+				memory += pipeline->job.memory;
+				++it;
+			}
+		}
+
+		// Start pending jobs while there is capacity. A job which 
+		// would exceed the memory budget waits for running jobs to 
+		// finish, but always runs if nothing else is.
+		bool pending = false;
+		for (std::size_t i = 0; i < _jobs.size() && 
+			(int)_pipelines.size() < _options.concurrency; i++) {
+			TranscodeJob& job = _jobs[i];
+			if (job.state != TranscodeJob::Pending)
+				continue;
+			pending = true;
+			if (_options.memoryBudget && job.memory && !_pipelines.empty() &&
+				memory + job.memory > _options.memoryBudget)
+				continue;
+
+			Pipeline* pipeline = nullptr;
+			try {
+				pipeline = new Pipeline(i, job, _options.encoder);
+				job.memory = pipeline->job.memory;
+				if (_options.memoryBudget && !_pipelines.empty() &&
+					memory + job.memory > _options.memoryBudget) {
+					delete pipeline;
+					continue;
+				}
+			}
+			catch (std::exception& exc) {
+				ErrorLS(this) << "Cannot open job: " << job.ifile << ": " << exc.what() << endl;
+				if (pipeline)
+					delete pipeline;
+				job.state = TranscodeJob::Failed;
+				job.error = exc.what();
+				finished.push_back(job);
+				changed = true;
+				continue;
+			}
+
+			TraceLS(this) << "Job starting: " << job.ifile << endl;
+			job.state = TranscodeJob::Running;
+			pipeline->job.state = TranscodeJob::Running;
+			memory += job.memory;
+			_pipelines.push_back(pipeline);
+			pipeline->start();
+			changed = true;
+		}
+
+		if (!pending && _pipelines.empty() && !_complete) {
+			for (auto it = _jobs.begin(); it != _jobs.end(); ++it) {
+				if (it->state == TranscodeJob::Pending)
+					pending = true;
+			}
+			complete = _complete = !pending;
+		}
+	}
+	
+	if (changed)
+		save();
+	for (auto it = finished.begin(); it != finished.end(); ++it)
+		JobComplete.emit(this, *it);
+	if (complete) {
+		TraceLS(this) << "Complete" << endl;
+		Complete.emit(this);
+		cancel();
+	}
+}
+
+
+void TranscodeRunner::load()
+{
+	if (_options.stateFile.empty() || !fs::exists(_options.stateFile))
+		return;
+
+	// One job per line: state, input path, output path
+	std::ifstream ifs(_options.stateFile.c_str());
+	std::string line;
+	Mutex::ScopedLock lock(_mutex);
+	while (std::getline(ifs, line)) {
+		std::vector<std::string> fields = util::split(line, '\t');
+		if (fields.size() < 3)
+			continue;
+		TranscodeJob job(fields[1], fields[2]);
+		job.state = (TranscodeJob::State)util::strtoi<int>(fields[0]);
+		if (job.state == TranscodeJob::Running)
+			job.state = TranscodeJob::Pending; // interrupted
+		_jobs.push_back(job);
+	}
+
+	TraceLS(this) << "Loaded " << _jobs.size() << " jobs" << endl;
+}
+
+
+void TranscodeRunner::save()
+{
+	if (_options.stateFile.empty())
+		return;
+
+	// Write to a temporary file and rename it over the state 
+	// file, so an interruption never leaves a truncated state.
+	std::string temp(_options.stateFile + ".tmp");
+	{
+		std::ofstream ofs(temp.c_str(), std::ios::out | std::ios::trunc);
+		Mutex::ScopedLock lock(_mutex);
+		for (auto it = _jobs.begin(); it != _jobs.end(); ++it)
+			ofs << it->state << '\t' << it->ifile << '\t' << it->ofile << '\n';
+	}
+	fs::rename(temp, _options.stateFile);
+}
+
+
+std::vector<TranscodeJob> TranscodeRunner::jobs() const
+{
+	Mutex::ScopedLock lock(_mutex);
+	return _jobs;
+}
+
+
+TranscodeRunner::Options& TranscodeRunner::options() 
+{
+	Mutex::ScopedLock lock(_mutex);
+	return _options;
+}
+
+
+} } // namespace scy::av
+
+
+#endif
@@ -0,0 +1,677 @@
+﻿//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "scy/media/videoanalyzer.h"
+
+
+#ifdef HAVE_FFMPEG
+
+#include <algorithm>
+#include <limits>
+
+
+using std::endl;
+
+
+namespace scy {
+namespace av {
+
+
+struct VideoAnalyzer::Worker
+	/// Analyzes a single time range of the input file 
+	/// using its own reader and FFT streams.
+{
+	struct Result
+	{
+		bool video;
+		VideoAnalyzer::Packet packet;
+		Result(bool video, const VideoAnalyzer::Packet& packet) : 
+			video(video), packet(packet) {}
+	};
+
+	VideoAnalyzer* analyzer;
+	double startTime;
+	double endTime;
+	AVInputReader reader;
+	VideoAnalyzer::Stream* video;
+	VideoAnalyzer::Stream* audio;
+	VideoConversionContext* conv;
+	std::vector<Result> results;
+	std::string error;
+	Thread thread;
+
+	Worker(VideoAnalyzer* analyzer, double startTime, double endTime) : 
+		analyzer(analyzer), startTime(startTime), endTime(endTime), 
+		video(nullptr), audio(nullptr), conv(nullptr)
+	{
+		const VideoAnalyzer::Options& options = analyzer->_options;
+		reader.options().processVideoXFrame = options.videoDecimation;
+		reader.openFile(options.ifile);
+		if (reader.video()) {
+			video = new VideoAnalyzer::Stream("Video", options.rdftSize);
+			video->initialize();	
+		}
+		if (reader.audio()) {
+			audio = new VideoAnalyzer::Stream("Audio", options.rdftSize);
+			audio->initialize();
+		}
+		reader += packetDelegate(this, &Worker::onVideo);
+		reader += packetDelegate(this, &Worker::onAudio);
+	}
+
+	~Worker()
+	{
+		reader.detach(this);
+		if (video)
+			delete video;
+		if (audio)
+			delete audio;
+		if (conv)
+			delete conv;
+	}
+
+	void run()
+	{
+		try {
+			if (startTime > 0 && av_seek_frame(reader.formatCtx(), -1, 
+					(Int64)(startTime * AV_TIME_BASE), AVSEEK_FLAG_BACKWARD) < 0)
+				throw std::runtime_error("Cannot seek to the range start.");
+			reader.run();
+			error = reader.error();
+		}
+		catch (std::exception& exc) {
+			error = exc.what();
+		}
+	}
+
+	void onVideo(void*, VideoPacket& packet)
+	{
+		// Decoding starts at the keyframe before the range
+		if (packet.time < startTime)
+			return;
+		if (packet.time >= endTime) {
+			reader.stop();
+			return;
+		}
+		if (!conv)
+			conv = analyzer->createGrayConverter(reader.video());
+		VideoAnalyzer::Packet pkt(packet.time);
+		if (analyzer->analyzeVideo(*video, conv->convert(reader.video()->frame), pkt))
+			results.push_back(Result(true, pkt));
+	}
+
+	void onAudio(void*, AudioPacket& packet)
+	{
+		if (packet.time < startTime)
+			return;
+		if (packet.time >= endTime) {
+			if (!video)
+				reader.stop();
+			return;
+		}
+		VideoAnalyzer::Packet pkt(packet.time);
+		if (analyzer->analyzeAudio(*audio, packet, reader.audio()->stream->codec->channels, pkt))
+			results.push_back(Result(false, pkt));
+	}
+};
+
+
+VideoAnalyzer::VideoAnalyzer(const Options& options) : 
+	_options(options),
+	_video(nullptr),
+	_audio(nullptr),
+	_videoConv(nullptr)
+{
+	TraceLS(this) << "Create" << endl;
+}
+
+
+VideoAnalyzer::~VideoAnalyzer() 
+{
+	TraceLS(this) << "Destroy" << endl;
+	uninitialize();
+}
+
+
+void VideoAnalyzer::initialize()
+{
+	if (_options.ifile.empty())
+		throw std::runtime_error("Please specify an input file.");
+
+	TraceLS(this) << "Loading: " << _options.ifile << endl;
+
+	_error = "";
+
+	// Open the input file decoder.
+	_reader.options().processVideoXFrame = _options.videoDecimation;
+	_reader.openFile(_options.ifile);
+		
+	if (_reader.video()) {
+		_videoConv = nullptr;
+		_video = new VideoAnalyzer::Stream("Video", _options.rdftSize);
+		_video->initialize();	
+	}
+
+	if (_reader.audio()) {
+		_audio = new VideoAnalyzer::Stream("Audio", _options.rdftSize);
+		_audio->initialize();
+	}
+	
+	_reader += packetDelegate(this, &VideoAnalyzer::onVideo);
+	_reader += packetDelegate(this, &VideoAnalyzer::onAudio);
+
+	_reader.ReadComplete += sdelegate(this, &VideoAnalyzer::onReadComplete);
+}
+
+	
+void VideoAnalyzer::uninitialize()
+{
+	//TraceL << "[VideoAnalyzerStream: " << this << ": " << name << "] Uninitializing" << endl;	
+	stop();
+	
+	//Mutex::ScopedLock lock(_mutex); 
+
+	if (_video)
+		delete _video;
+	if (_videoConv)
+		delete _videoConv;
+	if (_audio)
+		delete _audio;
+}
+
+
+void VideoAnalyzer::start()
+{
+	Mutex::ScopedLock lock(_mutex); 
+	
+	try 
+	{
+		if (!_reader.audio() && !_reader.video())
+			throw std::runtime_error("Video reader not initialized");
+
+		//if (_options.blocking)
+		//	_reader.run();
+		//else
+		if (_options.threads > 1 && 
+			_reader.formatCtx()->duration != AV_NOPTS_VALUE)
+			_thread.start(std::bind(&VideoAnalyzer::runParallel, this));
+		else
+			_reader.start();
+	} 
+	catch (std::exception& exc) 
+	{
+		_error = exc.what();
+		ErrorLS(this) << "Error: " << _error << endl;
+		throw exc; //.rethrow()
+	}
+}
+
+
+void VideoAnalyzer::stop() 
+{
+	
+	// Can't lock here in case we inside a callback.
+	//Mutex::ScopedLock lock(_mutex); 
+	
+	_reader.ReadComplete -= sdelegate(this, &VideoAnalyzer::onReadComplete);
+	_reader.detach(this);
+	_reader.stop();
+
+	{
+		Mutex::ScopedLock lock(_workerMutex); 
+		for (auto it = _workers.begin(); it != _workers.end(); ++it)
+			(*it)->reader.stop();
+	}
+	if (_thread.running() && 
+		_thread.tid() != Thread::currentID())
+		_thread.join();
+}
+
+
+void VideoAnalyzer::onVideo(void*, VideoPacket& packet)
+{
+	//TraceLS(this) << "On video: " 
+	//	<< packet.size() << ": " << packet.time << endl;
+	
+	VideoAnalyzer::Packet pkt(packet.time);
+	AVFrame* greyFrame = getGrayVideoFrame();
+	
+	Mutex::ScopedLock lock(_mutex); 
+	if (analyzeVideo(*_video, greyFrame, pkt))
+		PacketOut.emit(this, *_video, pkt);
+}
+
+
+void VideoAnalyzer::onAudio(void*, AudioPacket& packet)
+{
+	//TraceLS(this) << "On Audio: " 
+	//  << packet.size() << ": " << packet.time << endl;	
+
+	Mutex::ScopedLock lock(_mutex);		
+	
+	VideoAnalyzer::Packet pkt(packet.time);
+	if (analyzeAudio(*_audio, packet, _reader.audio()->stream->codec->channels, pkt))
+		PacketOut.emit(this, *_audio, pkt);
+}
+
+
+bool VideoAnalyzer::analyzeVideo(VideoAnalyzer::Stream& stream, AVFrame* frame, VideoAnalyzer::Packet& pkt)
+{
+	// Prepeare FFT input data array
+	//	http://stackoverflow.com/questions/7790877/forward-fft-an-image-and-backward-fft-an-image-to-get-the-same-result
+	//	https://code.google.com/p/video-processing-application/source/browse/trunk/+video-processing-application/untitled6/Fourier/highpassrgb.cpp?r=2
+	//	http://codepaste.ru/9226/
+	Int64 frames = stream.frames;
+	stream.fillVideo(frame->data[0], frame->width, frame->height, frame->linesize[0]);
+	pkt.value = stream.transform();
+	frames = stream.frames - frames;
+	if (!frames)
+		return false;
+
+	// Calculate and scale the average value for this video frame
+	pkt.value /= frames;
+	pkt.value = sqrt(pkt.value); ///= _video->rdftSize;
+
+	TraceLS(this) << "Video Output: "
+		<< pkt.time << ", " << pkt.value << endl;
+	return true;
+}
+
+
+bool VideoAnalyzer::analyzeAudio(VideoAnalyzer::Stream& stream, AudioPacket& packet, int channels, VideoAnalyzer::Packet& pkt)
+{
+	short const* data = reinterpret_cast<short*>(packet.data());
+	int size = packet.size();
+	
+	// Packet size / 2 = 2 bytes per sample (short)
+	// Example at http://blackhole.ubitux.fr/bench-fftw-ffmpeg-fft/fft.c
+	stream.reserve(size / 2 / channels + 1);
+    for (int i = 0; i < size / 2; i += channels) {
+        int k, v = 0;
+        for (k = 0; k < channels; k++) // mix channels
+            v += data[i + k];
+        stream.rdftData[stream.filled++] = (float)v / channels / SHRT_MAX;
+    }
+	
+	Int64 frames = stream.frames;
+	pkt.value = stream.transform();
+	frames = stream.frames - frames;
+	if (!frames)
+		return false;
+
+	// Calculate the average value for this audio frame
+	pkt.value /= frames;
+
+	TraceLS(this) << "Audio Output: "
+		<< pkt.time << ", " << pkt.value << endl;
+	return true;
+}
+
+
+void VideoAnalyzer::runParallel()
+{
+	TraceLS(this) << "Running parallel: " << _options.threads << endl;
+
+	// Split the file into equal time ranges. The last range
+	// is open ended in case the duration is an estimate.
+	std::string error;
+	AVFormatContext* format = _reader.formatCtx();
+	double begin = format->start_time != AV_NOPTS_VALUE ? 
+		(double)format->start_time / AV_TIME_BASE : 0.0;
+	double range = ((double)format->duration / AV_TIME_BASE) / _options.threads;
+	try {
+		Mutex::ScopedLock lock(_workerMutex); 
+		for (int i = 0; i < _options.threads; i++) {
+			double end = i == _options.threads - 1 ? 
+				std::numeric_limits<double>::max() : begin + range * (i + 1);
+			Worker* worker = new Worker(this, i ? begin + range * i : 0.0, end);
+			_workers.push_back(worker);
+			worker->thread.start(std::bind(&Worker::run, worker));
+		}
+	}
+	catch (std::exception& exc) {
+		error = exc.what();
+		ErrorLS(this) << "Worker error: " << error << endl;
+	}
+	
+	std::vector<Worker*> workers;
+	{
+		Mutex::ScopedLock lock(_workerMutex); 
+		workers = _workers;
+	}
+	for (auto it = workers.begin(); it != workers.end(); ++it)
+		(*it)->thread.join();
+
+	// Merge the results in timestamp order
+	std::vector<Worker::Result> results;
+	for (auto it = workers.begin(); it != workers.end(); ++it) {
+		Worker* worker = *it;
+		results.insert(results.end(), worker->results.begin(), worker->results.end());
+		if (error.empty())
+			error = worker->error;
+		if (_video && worker->video)
+			_video->frames += worker->video->frames;
+		if (_audio && worker->audio)
+			_audio->frames += worker->audio->frames;
+	}
+	std::stable_sort(results.begin(), results.end(), 
+		[](const Worker::Result& l, const Worker::Result& r) { 
+			return l.packet.time < r.packet.time; 
+		});
+
+	{
+		Mutex::ScopedLock lock(_workerMutex); 
+		_workers.clear();
+	}
+	{
+		Mutex::ScopedLock lock(_mutex); 
+		if (_error.empty())
+			_error = error;
+	}
+	for (auto it = workers.begin(); it != workers.end(); ++it)
+		delete *it;
+
+	for (auto it = results.begin(); it != results.end(); ++it) {
+		if (it->video)
+			PacketOut.emit(this, *_video, it->packet);
+		else
+			PacketOut.emit(this, *_audio, it->packet);
+	}
+	
+	TraceLS(this) << "Running parallel: Complete" << endl;
+	Complete.emit(this);
+}
+
+
+AVFrame* VideoAnalyzer::getGrayVideoFrame()
+{		
+	Mutex::ScopedLock lock(_mutex); 
+	VideoDecoderContext* video = _reader.video();
+
+	// TODO: Conversion via decoder?
+	if (_videoConv == nullptr)
+		_videoConv = createGrayConverter(video);
+		
+	// Convert the source image to grayscale
+	return _videoConv->convert(video->frame);
+}
+
+
+VideoConversionContext* VideoAnalyzer::createGrayConverter(VideoDecoderContext* video)
+{
+	// Downscaling is done by the conversion context 
+	// at no extra cost.
+	int scale = std::max(_options.videoScale, 1);
+	VideoCodec iparams;
+	iparams.width = video->ctx->width;
+	iparams.height = video->ctx->height;
+	iparams.pixelFmt = av_get_pix_fmt_name(video->ctx->pix_fmt);
+	VideoCodec oparams;
+	oparams.width = std::max(video->ctx->width / scale, 1);
+	oparams.height = std::max(video->ctx->height / scale, 1);
+	oparams.pixelFmt = "gray";		
+	VideoConversionContext* conv = new VideoConversionContext();
+	try {
+		conv->create(iparams, oparams, &_grayFrames);
+	}
+	catch (...) {
+		delete conv;
+		throw;
+	}
+	return conv;
+}
+
+
+void VideoAnalyzer::onReadComplete(void* sender)
+{
+	TraceLS(this) << "On Read Complete" << endl;	
+
+	AVInputReader* reader = reinterpret_cast<AVInputReader*>(sender);	
+	{
+		Mutex::ScopedLock lock(_mutex); 
+		if (_error.empty())
+			_error = reader->error();
+	}
+
+	Complete.emit(this);
+}
+
+
+AVInputReader& VideoAnalyzer::reader()
+{ 
+	Mutex::ScopedLock lock(_mutex);
+	return _reader; 
+}
+
+
+VideoAnalyzer::Options& VideoAnalyzer::options()
+{ 
+	Mutex::ScopedLock lock(_mutex);
+	return _options; 
+}
+
+
+std::string VideoAnalyzer::error() const
+{
+	Mutex::ScopedLock lock(_mutex);	
+	return _error;
+}
+
+
+// ---------------------------------------------------------------------
+//
+VideoAnalyzer::Packet::Packet(double time, double value) : //, double min, double max
+			time(time), value(value)
+{	
+	//this->min = min;
+	//this->max = max;
+}
+	
+
+// ---------------------------------------------------------------------
+//
+const int kMaxFFTPow2Size = 24;
+
+
+VideoAnalyzer::Stream::Stream(const std::string& name, int rdftSize) : 
+	name(name), rdftSize(rdftSize), rdftBits(static_cast<int>(log2(rdftSize))), 
+	rdft(nullptr), rdftData(nullptr), rdftCapacity(0), frames(0), filled(0)
+{	
+	TraceL << "[VideoAnalyzerStream: " << this << ": " << name << "] Creating: " 
+		<< rdftSize << ": " << rdftBits << endl;	
+
+    assert(rdftSize);
+    assert(rdftBits < kMaxFFTPow2Size);
+
+	// We only allow power of two.
+    assert(int(1UL << rdftBits) == rdftSize);
+}
+	
+
+VideoAnalyzer::Stream::~Stream()
+{
+	uninitialize();
+}
+
+
+void VideoAnalyzer::Stream::initialize()
+{
+	frames		= 0;
+	filled		= 0;
+
+	assert(rdft == nullptr);
+	rdft = av_rdft_init(rdftBits, DFT_R2C);
+	if (rdft == nullptr)
+		throw std::runtime_error("Cannot allocate FFT context");
+	
+	assert(rdftData == nullptr);
+	rdftData = (FFTSample*)av_malloc(rdftSize * sizeof(*rdftData));	
+	if (rdftData == nullptr)
+		throw std::runtime_error("Cannot allocate FFT buffer");
+	rdftCapacity = rdftSize;
+}
+
+	
+void VideoAnalyzer::Stream::uninitialize()
+{
+	//TraceL << "[VideoAnalyzerStream: " << this << ": " << name << "] Uninitializing" << endl;	
+	
+	if (rdft)
+		av_rdft_end(rdft);
+	if (rdftData)
+		av_free(rdftData);
+	rdft = nullptr;
+	rdftData = nullptr;
+	rdftCapacity = 0;
+}
+
+
+void VideoAnalyzer::Stream::fft()
+{
+	assert(filled == rdftSize);
+    av_rdft_calc(rdft, rdftData);	
+}
+
+
+void VideoAnalyzer::Stream::reserve(int samples)
+{
+	if (filled + samples <= rdftCapacity)
+		return;
+
+	// Round up to whole blocks so every block stays aligned
+	int capacity = ((filled + samples) / rdftSize + 1) * rdftSize;
+	FFTSample* data = (FFTSample*)av_malloc(capacity * sizeof(*data));	
+	if (data == nullptr)
+		throw std::runtime_error("Cannot allocate FFT buffer");
+	if (filled)
+		memcpy(data, rdftData, filled * sizeof(*data));
+	av_free(rdftData);
+	rdftData = data;
+	rdftCapacity = capacity;
+}
+
+
+double VideoAnalyzer::Stream::transform()
+{
+	double intensity = 0.0;
+	int offset = 0;
+	for (; offset + rdftSize <= filled; offset += rdftSize) {
+		av_rdft_calc(rdft, rdftData + offset);
+		intensity += CalculateFrequencyIntensity(rdftData + offset, rdftSize);
+		frames++;
+	}
+
+	filled -= offset;
+	if (offset && filled)
+		memmove(rdftData, rdftData + offset, filled * sizeof(*rdftData));
+	return intensity;
+}
+
+
+void VideoAnalyzer::Stream::fillVideo(const UInt8* data, int width, int height, int step)
+{
+	// Row y starts at signs[y & 1], which replaces pow(-1, x + y)
+	if ((int)signs.size() < width + 1) {
+		signs.resize(width + 1);
+		for (int i = 0; i < width + 1; i++)
+			signs[i] = (i & 1) ? -1.0f : 1.0f;
+	}
+
+	reserve(width * height);
+	FFTSample* out = rdftData + filled;
+	for (int y = 0; y < height; y++) {
+		const UInt8* row = data + y * step;
+		const FFTSample* sign = &signs[y & 1];
+		for (int x = 0; x < width; x++)
+			out[x] = row[x] * sign[x];
+		out += width;
+	}
+	filled += width * height;
+}
+
+
+// ---------------------------------------------------------------------
+//
+double CalculateCentroidFrequency(VideoAnalyzer::Stream& stream)
+{
+	// These two values are used for getting the Spectral Centroid
+	// http://en.wikipedia.org/wiki/Spectral_centroid
+	double centroidFnXn = 0;
+	double centroidXn = 0;	
+			
+	for (int i = 0; i < stream.filled / 2; i += 2) {				
+		centroidFnXn += i * abs(stream.rdftData[i]);
+		centroidXn += abs(stream.rdftData[i]);
+	}
+			
+	return centroidFnXn / centroidXn;
+}
+
+
+double CalculateFrequencyIntensity(VideoAnalyzer::Stream& stream)
+{
+	return CalculateFrequencyIntensity(stream.rdftData, stream.filled);
+}
+
+
+double CalculateFrequencyIntensity(const FFTSample* data, int size)
+{
+	double intensity = 0.0;			
+	for (int i = 0; i < size / 2; i += 2) {
+		intensity += GetFrequencyIntensity(data[i], data[i+1]);
+	}
+	return intensity;
+}
+
+
+double GetFrequencyIntensity(double re, double im)
+{
+    return sqrt((re*re)+(im*im));
+}
+
+
+double GetDecibels(double re, double im)
+{
+	return (re == 0 && im == 0) ? 0 : 
+		10.0 * log10(re*re+im*im);
+}
+
+double GetAmplitude(double re, double im, int len) 
+{
+	return GetFrequencyIntensity(re,im)/(len);
+}
+
+double GetAmplitudeScaled(double re, double im, int len, int scale) 
+{
+	return static_cast<int>(GetAmplitude(re,im,len)) % scale;
+}
+
+
+#ifdef WIN32
+double log2(double n) 
+{
+	return log(n) / log(double(2));
+}
+#endif
+
+
+} } // namespace scy::av
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,121 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#ifndef SCY_Net_DNSCache_H
+#define SCY_Net_DNSCache_H
+
+
+#include "scy/net/network.h"
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <memory>
+
+
+namespace scy {
+namespace net {
+
+
+class DNSCache
+	/// DNSCache sits in front of the libuv resolver and remembers
+	/// resolved addresses for a bounded amount of time.
+	///
+	/// Concurrent lookups for the same host are coalesced into a
+	/// single resolver request, failed lookups are negatively cached
+	/// for a shorter period, and the least recently used entries are
+	/// evicted once the size limit is reached.
+	///
+	/// The system resolver does not expose record TTLs, so entry
+	/// lifetimes are configured per cache instead.
+	///
+	/// The cache is not thread-safe and must be used from the thread
+	/// running its event loop. Cached hits call back synchronously.
+{
+public:
+	DNSCache(uv::Loop* loop = uv::defaultLoop(), std::size_t limit = 256, 
+		Int64 ttl = 5 * 60 * 1000, Int64 negativeTTL = 10 * 1000);
+	virtual ~DNSCache();
+
+	bool resolve(const std::string& host, UInt16 port, 
+		std::function<void(const DNSResult&)> callback, void* opaque = nullptr);
+		// Resolves the given host and port, calling back immediately
+		// if a fresh cached result exists.
+		// Returns false if the resolver request could not be started.
+
+	void invalidate(const std::string& host, UInt16 port);
+		// Drops the cached entry for the given host and port.
+		// Pending lookups are unaffected.
+
+	void clear();
+		// Drops all cached entries. Callbacks for pending lookups 
+		// will not be called.
+
+	std::size_t size() const;
+		// Returns the number of cached and pending entries.
+
+	uv::Loop* loop() const;
+		// Returns the event loop used for resolving.
+
+	static DNSCache& shared(uv::Loop* loop = uv::defaultLoop());
+		// Returns the cache shared by all sockets on the given loop,
+		// creating it on first use. The shared cache is destroyed
+		// when an Application on the loop is finalized.
+
+	static void destroyShared(uv::Loop* loop = uv::defaultLoop());
+		// Destroys the shared cache for the given loop. Callbacks
+		// for pending lookups will not be called.
+
+protected:
+	struct Waiter
+	{
+		std::function<void(const DNSResult&)> callback;
+		void* opaque;
+	};
+
+	struct Entry
+	{
+		std::vector<net::Address> addrs;
+		std::vector<Waiter> waiters;
+		std::list<std::string>::iterator lru;
+		Int64 expires;
+		bool resolving;
+	};
+
+	void onResolved(const std::string& key, const DNSResult& result);
+	void touch(Entry& entry);
+	void prune();
+	
+	typedef std::map<std::string, Entry> EntryMap;
+	
+	uv::Loop* _loop;
+	std::size_t _limit;
+	Int64 _ttl;
+	Int64 _negativeTTL;
+	EntryMap _entries;
+	std::list<std::string> _lru;
+	std::shared_ptr<DNSCache*> _self;
+};
+
+
+} } // namespace scy::net
+
+
+#endif // SCY_Net_DNSCache_H
@@ -0,0 +1,188 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef SCY_Net_Network_H
+#define SCY_Net_Network_H
+
+
+#include "scy/types.h"
+#include "scy/uv/uvpp.h"
+
+#include "scy/net/address.h"
+#include <vector>
+#include <algorithm>
+
+
+namespace scy {
+namespace net {
+	
+
+//
+// Network Interfaces
+//
+
+
+inline void getNetworkInterfaces(std::vector<net::Address>& hosts)
+{	
+    uv_interface_address_t *info;
+    int count, i;
+
+    uv_interface_addresses(&info, &count);
+    i = count;
+
+    while (i--) {
+        uv_interface_address_t iface = info[i];
+		hosts.push_back(net::Address(reinterpret_cast<const sockaddr*>(&iface.address.address4), 16));
+    }
+
+    uv_free_interface_addresses(info, count);
+}
+
+
+//
+/// DNS Resolver
+//
+// Example: 
+//
+// static void onDNSResult(const net::DNSResult& result)
+// {
+//     do something with result
+// }
+// net::resolveDNS("google.com", 80, onDNSResult);
+
+
+struct DNSResult
+{
+	std::string host;
+		// The host to resolve
+
+	UInt16 port;
+		// The host port to resolve
+
+	net::Address addr;
+		// The resolved address
+
+	std::vector<net::Address> addrs;
+		// All resolved addresses in resolver preference order
+
+	struct addrinfo* info;
+		// The libuv uv_getaddrinfo result.
+		// Only valid inside the callback, and nullptr 
+		// for results served from a DNSCache.
+
+	uv::Loop* loop;
+		// The event loop to resolve on (optional)
+
+	struct addrinfo* hints;
+		// libuv uv_getaddrinfo hints (optional)
+	
+	std::function<void(const DNSResult&)> callback;
+		// Result callback function
+
+	void* opaque;
+		// Client data pointer
+
+	enum Status {
+		None,
+		Resolving,
+		Success,
+		Failed
+	} status;
+
+	bool resolving() const { return status == Resolving; }
+	bool success() const { return status == Success; }
+	bool failed() const { return status == Failed; }
+	bool complete() const { return status == Success || status == Failed; }
+
+	DNSResult() : info(nullptr), loop(nullptr), hints(nullptr), opaque(nullptr), status(None) {}
+};
+
+
+inline void onDNSResolved(uv_getaddrinfo_t* handle, int status, struct addrinfo* res)
+{	
+	DNSResult* dns = reinterpret_cast<DNSResult*>(handle->data);	
+	
+	// Collect every unique usable address. The resolver returns one 
+	// entry per socket type unless hints are given, and addresses 
+	// of families we weren't built with are skipped.
+	for (struct addrinfo* ai = status == 0 ? res : nullptr; ai; ai = ai->ai_next) {
+		try {
+			net::Address addr(ai->ai_addr, (socklen_t)ai->ai_addrlen);
+			if (std::find(dns->addrs.begin(), dns->addrs.end(), addr) == dns->addrs.end())
+				dns->addrs.push_back(addr);
+		}
+		catch (std::exception&) {}
+	}
+	
+	dns->status = dns->addrs.empty() ? DNSResult::Failed : DNSResult::Success;
+	dns->info = res;
+	if (!dns->addrs.empty())
+		dns->addr = dns->addrs.front();
+	traceL("Network") << "DNS resolved: " << dns->host << ": " << dns->addrs.size() << std::endl;
+	
+	dns->callback(*dns);
+
+	if (res)
+		uv_freeaddrinfo(res);	
+	delete handle;
+	delete dns;
+}
+
+
+inline bool resolveDNS(DNSResult* dns) 
+{			
+	//traceL("Network") << "Resolving DNS: " << dns->host << ":" << dns->port << std::endl;
+
+	assert(dns->port);
+	assert(!dns->host.empty());
+	assert(dns->callback);
+	dns->status = DNSResult::Resolving;
+	
+	uv_getaddrinfo_t* handle = new uv_getaddrinfo_t;
+	handle->data = dns;
+	if (uv_getaddrinfo(dns->loop ? dns->loop : uv_default_loop(), handle, onDNSResolved, dns->host.c_str(), util::itostr<UInt16>(dns->port).c_str(), dns->hints) != 0) {
+		// The DNSResult remains owned by the caller on failure
+		dns->status = DNSResult::Failed;
+		delete handle;
+		return false;
+	}
+	return true;
+}
+
+
+inline bool resolveDNS(const std::string& host, UInt16 port, std::function<void(const DNSResult&)> callback, void* opaque = nullptr, struct addrinfo* hints = nullptr)
+{		
+	DNSResult* dns = new DNSResult();
+	dns->host = host;
+	dns->port = port;
+	dns->opaque = opaque;
+	dns->hints = hints;
+	dns->callback = callback;
+	if (!resolveDNS(dns)) {
+		delete dns;
+		return false;
+	}
+	return true;
+}
+
+
+} } // namespace scy::net
+
+
+#endif // SCY_Net_Network_H
@@ -0,0 +1,19 @@
+#include "flashpolicyserver.h"
+#include "scy/application.h"
+#include "scy/logger.h"
+
+
+int main(int argc, char** argv)
+{
+	/*
+	Logger::instance().add(new ConsoleChannel("debug", LTrace));	
+	{	
+		Application app;	
+		//SERVER_TYPE srv(SERVER_PORT);
+		//srv.shutdown();
+		//app.waitForShutdown(onShutdown, &srv);
+	}
+	Logger::destroy();
+	*/
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#include "scy/net/tcpsocket.h"
+#include "scy/net/sslsocket.h"
+
+
+namespace scy {
+namespace net {
+
+
+} } // namespace scy::net
\ No newline at end of file
@@ -0,0 +1,248 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#include "scy/net/dnscache.h"
+#include "scy/application.h"
+#include "scy/mutex.h"
+#include "scy/logger.h"
+
+
+using std::endl;
+
+
+namespace scy {
+namespace net {
+
+
+namespace internal {
+
+	struct SharedCaches
+	{
+		Mutex mutex;
+		std::map<uv::Loop*, DNSCache*> caches;
+	};
+
+	static SharedCaches& sharedCaches()
+	{
+		static SharedCaches instance;
+		return instance;
+	}
+
+} // namespace internal
+
+
+DNSCache::DNSCache(uv::Loop* loop, std::size_t limit, Int64 ttl, Int64 negativeTTL) :
+	_loop(loop),
+	_limit(limit),
+	_ttl(ttl),
+	_negativeTTL(negativeTTL),
+	_self(std::make_shared<DNSCache*>(this))
+{
+	TraceLS(this) << "Create" << endl;	
+}
+
+
+DNSCache::~DNSCache()
+{
+	TraceLS(this) << "Destroy" << endl;	
+
+	// Pending resolver callbacks hold a weak reference 
+	// and will be ignored once we are gone.
+	_self.reset();
+}
+
+
+bool DNSCache::resolve(const std::string& host, UInt16 port, 
+	std::function<void(const DNSResult&)> callback, void* opaque)
+{
+	std::string key(host + ":" + util::itostr<UInt16>(port));
+	Waiter waiter = { callback, opaque };
+
+	auto it = _entries.find(key);
+	if (it != _entries.end()) {
+		Entry& entry = it->second;
+		if (entry.resolving) {
+			TraceLS(this) << "Waiting on pending lookup: " << key << endl;
+			entry.waiters.push_back(waiter);
+			return true;
+		}
+		if (entry.expires > (Int64)uv_now(_loop)) {
+			TraceLS(this) << "Cache hit: " << key << endl;
+			touch(entry);
+			DNSResult result;
+			result.host = host;
+			result.port = port;
+			result.loop = _loop;
+			result.addrs = entry.addrs;
+			if (!result.addrs.empty())
+				result.addr = result.addrs.front();
+			result.status = result.addrs.empty() ? DNSResult::Failed : DNSResult::Success;
+			result.callback = callback;
+			result.opaque = opaque;
+			callback(result);
+			return true;
+		}
+
+		// Expired
+		_lru.erase(entry.lru);
+		_entries.erase(it);
+	}
+
+	TraceLS(this) << "Cache miss: " << key << endl;
+	Entry& entry = _entries[key];
+	entry.resolving = true;
+	entry.expires = 0;
+	entry.waiters.push_back(waiter);
+	_lru.push_front(key);
+	entry.lru = _lru.begin();
+
+	std::weak_ptr<DNSCache*> self(_self);
+	auto dns = new DNSResult;
+	dns->host = host;
+	dns->port = port;
+	dns->loop = _loop;
+	dns->status = DNSResult::Resolving;
+	dns->callback = [self, key](const DNSResult& result) {
+		auto ptr = self.lock();
+		if (ptr)
+			(*ptr)->onResolved(key, result);
+	};
+	if (!resolveDNS(dns)) {
+		delete dns;
+		_lru.erase(entry.lru);
+		_entries.erase(key);
+		return false;
+	}
+	return true;
+}
+
+
+void DNSCache::onResolved(const std::string& key, const DNSResult& result)
+{
+	auto it = _entries.find(key);
+	if (it == _entries.end() || !it->second.resolving) {
+		TraceLS(this) << "Dropping cleared lookup: " << key << endl;
+		return;
+	}
+
+	Entry& entry = it->second;
+	entry.resolving = false;
+	entry.addrs = result.addrs;
+	entry.expires = (Int64)uv_now(_loop) + (result.success() ? _ttl : _negativeTTL);
+	touch(entry);
+
+	// Take the waiters before calling back, since callbacks 
+	// may re-enter the cache or trigger pruning.
+	std::vector<Waiter> waiters;
+	waiters.swap(entry.waiters);
+	prune();
+
+	DNSResult res(result);
+	for (auto& waiter : waiters) {
+		res.callback = waiter.callback;
+		res.opaque = waiter.opaque;
+		waiter.callback(res);
+	}
+}
+
+
+void DNSCache::invalidate(const std::string& host, UInt16 port)
+{
+	auto it = _entries.find(host + ":" + util::itostr<UInt16>(port));
+	if (it != _entries.end() && !it->second.resolving) {
+		_lru.erase(it->second.lru);
+		_entries.erase(it);
+	}
+}
+
+
+void DNSCache::clear()
+{
+	_entries.clear();
+	_lru.clear();
+}
+
+
+std::size_t DNSCache::size() const
+{
+	return _entries.size();
+}
+
+
+uv::Loop* DNSCache::loop() const
+{
+	return _loop;
+}
+
+
+void DNSCache::touch(Entry& entry)
+{
+	_lru.splice(_lru.begin(), _lru, entry.lru);
+}
+
+
+void DNSCache::prune()
+{
+	// Evict least recently used entries, leaving 
+	// pending lookups alone so waiters are not lost.
+	auto it = _lru.end();
+	while (_entries.size() > _limit && it != _lru.begin()) {
+		--it;
+		auto entry = _entries.find(*it);
+		if (entry != _entries.end() && !entry->second.resolving) {
+			_entries.erase(entry);
+			it = _lru.erase(it);
+		}
+	}
+}
+
+
+DNSCache& DNSCache::shared(uv::Loop* loop)
+{
+	auto& shared = internal::sharedCaches();
+	Mutex::ScopedLock lock(shared.mutex);
+	auto& cache = shared.caches[loop];
+	if (!cache) {
+		cache = new DNSCache(loop);
+		Application::addFinalizer(loop, [loop]() { 
+			DNSCache::destroyShared(loop); 
+		});
+	}
+	return *cache;
+}
+
+
+void DNSCache::destroyShared(uv::Loop* loop)
+{
+	DNSCache* cache = nullptr;
+	{
+		auto& shared = internal::sharedCaches();
+		Mutex::ScopedLock lock(shared.mutex);
+		auto it = shared.caches.find(loop);
+		if (it == shared.caches.end())
+			return;
+		cache = it->second;
+		shared.caches.erase(it);
+	}
+	delete cache;
+}
+
+
+} } // namespace scy::net
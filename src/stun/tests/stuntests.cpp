@@ -0,0 +1,246 @@
+#include "scy/base.h"
+#include "scy/platform.h"
+#include "scy/filesystem.h"
+#include "scy/logger.h"
+#include "scy/util.h"
+#include "scy/datetime.h"
+#include "scy/stun/message.h"
+#include "scy/crypto/hmac.h"
+
+#include <assert.h>
+#include <algorithm>
+#include <stdexcept>
+
+
+using namespace std;
+using namespace scy;
+
+
+/*
+// Detect Memory Leaks
+#ifdef _DEBUG
+#include "MemLeakDetect/MemLeakDetect.cpp"
+#include "MemLeakDetect/MemLeakDetect.h"
+CMemLeakDetect memLeakDetect;
+#endif
+*/
+
+
+namespace scy {
+namespace stun {
+	
+
+// TODO: Test vectors from http://tools.ietf.org/html/rfc5769
+
+
+class Tests
+{
+public:
+	Tests()
+	{					
+		//testMessageIntegrity();
+		//testXorAddress();
+		testReuestTypes();
+		testMessageIntegrityLength();
+#if 0
+		benchmarkMessageWrite();
+#endif
+	}
+
+	
+	void testMessageIntegrity() 
+	{	
+		std::string username("someuser");
+		std::string password("somepass");
+		
+		stun::Message request(stun::Message::Request, stun::Message::Allocate);
+		//request.setType(stun::Message::Allocate);
+		
+		auto usernameAttr = new stun::Username;
+		usernameAttr->copyBytes(username.c_str(), username.size());
+		request.add(usernameAttr);
+		
+		auto integrityAttr = new stun::MessageIntegrity;
+		integrityAttr->setKey(password);
+		request.add(integrityAttr);
+
+		Buffer buf;
+		request.write(buf);
+
+		stun::Message response;
+		response.read(constBuffer(buf));
+		
+		integrityAttr = response.get<stun::MessageIntegrity>();
+		assert(integrityAttr->verifyHmac(password));
+	}
+	
+	void testMessageIntegrityLength() 
+	{	
+		std::string username("someuser");
+		std::string password("somepass");
+		
+		stun::Message request(stun::Message::Request, stun::Message::Allocate);
+		
+		auto usernameAttr = new stun::Username;
+		usernameAttr->copyBytes(username.c_str(), username.size());
+		request.add(usernameAttr);
+		
+		auto integrityAttr = new stun::MessageIntegrity;
+		integrityAttr->setKey(password);
+		request.add(integrityAttr);
+
+		// Attributes following MESSAGE-INTEGRITY must be 
+		// excluded from the length used to compute the HMAC.
+		auto fingerprintAttr = new stun::Fingerprint;
+		fingerprintAttr->setValue(0x12345678);
+		request.add(fingerprintAttr);
+
+		Buffer buf;
+		request.write(buf);
+
+		std::size_t integrityOffset = kMessageHeaderSize + 
+			kAttributeHeaderSize + username.size();
+		std::size_t integrityEnd = integrityOffset + 
+			kAttributeHeaderSize + stun::MessageIntegrity::Size;
+		assert(buf.size() == integrityEnd + kAttributeHeaderSize + 4);
+
+		// The header length and magic cookie are left intact.
+		BitReader reader(buf);
+		UInt16 length;
+		UInt32 cookie;
+		reader.skip(2);
+		reader.getU16(length);
+		reader.getU32(cookie);
+		assert(length == buf.size() - kMessageHeaderSize);
+		assert(cookie == kMagicCookie);
+
+		// Recompute the HMAC with the 16-bit length field patched
+		// to the end of the MESSAGE-INTEGRITY attribute.
+		std::string input(buf.data(), integrityOffset);
+		BitWriter writer(&input[0], input.size());
+		bool patched = writer.updateU16((UInt16)(integrityEnd - kMessageHeaderSize), 2);
+		assert(patched);
+		std::string hmac(buf.data() + integrityOffset + kAttributeHeaderSize, 
+			stun::MessageIntegrity::Size);
+		assert(hmac == crypto::computeHMAC(input, password));
+
+		stun::Message response;
+		response.read(constBuffer(buf));		
+		integrityAttr = response.get<stun::MessageIntegrity>();
+		assert(integrityAttr->verifyHmac(password));
+		assert(!integrityAttr->verifyHmac("wrongpass"));
+	}
+	
+	void testReuestTypes() 
+	{	
+		UInt16 type = stun::Message::Indication | stun::Message::SendIndication;
+
+		//assert(IS_STUN_INDICATION(type));
+		
+		UInt16 classType = type & 0x0110;
+		UInt16 methodType = type & 0x000F;
+		
+		assert(classType == stun::Message::Indication);
+		assert(methodType == stun::Message::SendIndication);
+
+		stun::Message request(stun::Message::Indication, stun::Message::SendIndication);
+		//assert(IS_STUN_INDICATION(request.classType() | request.methodType()));
+			
+		assert(request.classType() != stun::Message::Request);
+		assert(request.classType() == stun::Message::Indication);
+
+		stun::Message request1(stun::Message::Request, stun::Message::Allocate);
+		//assert(IS_STUN_REQUEST(request1.classType() | request1.methodType()));
+	}
+	
+	
+	void benchmarkMessageWrite() 
+	{	
+		const int iterations = 100000;
+
+		stun::Message request(stun::Message::Request, stun::Message::Allocate);
+		
+		auto addrAttr = new stun::XorRelayedAddress;
+		addrAttr->setAddress(net::Address("192.168.1.1", 5555));
+		request.add(addrAttr);
+		
+		auto usernameAttr = new stun::Username;
+		usernameAttr->copyBytes("someuser", 8);
+		request.add(usernameAttr);
+		
+		auto integrityAttr = new stun::MessageIntegrity;
+		integrityAttr->setKey("somepass");
+		request.add(integrityAttr);
+
+		// Allocate a new buffer for each message
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < iterations; i++) {
+			Buffer buf;
+			request.write(buf);
+		}
+		sw.stop();
+		DebugL << "Message write: " << iterations << " messages in " 
+			<< sw.elapsedMilliseconds() << "ms" << endl;
+
+		// Reuse a single buffer so no allocations are made 
+		// after the first message.
+		Buffer buf;
+		sw.restart();
+		for (int i = 0; i < iterations; i++) {
+			buf.clear();
+			request.write(buf);
+		}
+		sw.stop();
+		DebugL << "Message write (reused buffer): " << iterations << " messages in " 
+			<< sw.elapsedMilliseconds() << "ms" << endl;
+
+		stun::Message response;
+		response.read(constBuffer(buf));
+		assert(response.get<stun::MessageIntegrity>()->verifyHmac("somepass"));
+	}
+	
+	
+	void testXorAddress() 
+	{	
+		assert(5555 == 0x15B3);
+		assert(5555 ^ (kMagicCookie >> 16) == 0x34A1);
+		
+		net::Address addr("192.168.1.1", 5555);
+		DebugL << "Source Address: " << addr << endl;
+		
+		stun::Message request(stun::Message::Request, stun::Message::Allocate);
+		//stun::Message request;
+		//request.setType(stun::Message::Allocate);
+		
+		auto addrAttr = new stun::XorRelayedAddress;
+		addrAttr->setAddress(addr);
+		request.add(addrAttr);
+		DebugL << "Request Address: " << addrAttr->address() << endl;
+
+		Buffer buf;
+		request.write(buf);
+
+		stun::Message response;
+		response.read(constBuffer(buf));
+				
+		addrAttr = response.get<stun::XorRelayedAddress>();	
+		
+		DebugL << "Response Address: " << addrAttr->address() << endl;
+		assert(addrAttr->address() == addr);
+	}
+};
+
+
+} } // namespace scy::stun
+
+
+int main(int argc, char** argv) 
+{	
+	Logger::instance().add(new ConsoleChannel("Test", LTrace));
+	{
+		stun::Tests app;
+	}	
+	Logger::destroy();
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef SCY_Symple_Router_H
+#define SCY_Symple_Router_H
+
+
+#include "scy/collection.h"
+#include "scy/symple/peer.h"
+#include "scy/symple/address.h"
+
+#include <unordered_map>
+#include <vector>
+
+
+namespace scy {
+namespace smpl {
+
+
+class Roster: public LiveCollection<std::string, Peer>
+	/// The Roster provides a registry for active network 
+	/// peers indexed by session ID.
+	///
+	/// Peers are looked up through a hashed ID index, and secondary
+	/// indexes by user and by group are kept for address based 
+	/// fan-out. The ordered base map is kept for iteration.
+{
+public:
+	typedef LiveCollection<std::string, Peer>	Manager;
+	typedef Manager::Map						PeerMap;	
+	typedef std::vector<Peer*>					PeerList;
+	
+public:
+	Roster();
+	virtual ~Roster();
+
+	virtual bool add(const std::string& id, Peer* peer, bool whiny = true);
+	virtual void update(const std::string& id, Peer* peer);
+	virtual Peer* get(const std::string& id, bool whiny = true) const;
+	virtual Peer* remove(const std::string& id);
+	virtual bool remove(const Peer* peer);
+	virtual bool exists(const std::string& id) const;
+	virtual bool exists(const Peer* peer) const;
+	virtual void clear();
+
+	virtual bool update(const std::string& id, const json::Value& data);
+		// Applies presence data to the peer, assigning only the members 
+		// which differ and removing those no longer present. The user 
+		// and group indexes are updated if either changes.
+		// Returns false if no peer has the given ID.
+	
+	Peer* getByHost(const std::string& host);
+		// Returns the first peer which matches the given host address.
+
+	PeerList byUser(const std::string& user) const;
+	PeerList byGroup(const std::string& group) const;
+		// Return the peers with the given user or group.
+
+	void match(const Address& address, PeerList& peers) const;
+		// Appends the peers matching the address to the list.
+		// The address matches a single peer if it has an ID, the
+		// user's peers (within the group, if set) if it has a user,
+		// or otherwise every peer in the group.
+	
+	virtual PeerMap peers() const;
+	
+	virtual void print(std::ostream& os) const;
+
+	//virtual const char* className() const { return "smpl::Roster"; }
+
+protected:
+	struct Entry
+	{
+		Peer* peer;
+		std::string user;
+		std::string group;
+		std::size_t userSlot;		// The position in the user list
+		std::size_t groupSlot;		// The position in the group list
+	};
+
+	typedef std::unordered_map<std::string, Entry> Index;
+	typedef std::unordered_map<std::string, std::vector<Entry*>> SecondaryIndex;
+		// Entries are referenced by pointer, which remains valid
+		// when the unordered map rehashes.
+
+	void index(const std::string& id, Peer* peer);
+	void unindex(Index::iterator it);
+	void link(SecondaryIndex& index, const std::string& key, Entry* entry, std::size_t Entry::*slot);
+	void unlink(SecondaryIndex& index, const std::string& key, Entry* entry, std::size_t Entry::*slot);
+
+	Index _index;
+	SecondaryIndex _users;
+	SecondaryIndex _groups;
+};
+	
+
+} } // namespace scy::smpl
+
+
+#endif //  SCY_Symple_Router_H
\ No newline at end of file
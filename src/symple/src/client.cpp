@@ -0,0 +1,610 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "scy/symple/client.h"
+#include "scy/net/tcpsocket.h"
+#include "scy/net/sslsocket.h"
+#include "scy/json/scanner.h"
+
+
+using std::endl;
+
+
+namespace scy {
+namespace smpl {
+
+
+//
+// TCP Client
+//
+
+
+Client* createTCPClient(const Client::Options& options, uv::Loop* loop)
+{
+	return new Client(std::make_shared<net::TCPSocket>(loop), options); //, loop
+}
+
+
+TCPClient::TCPClient(const Client::Options& options, uv::Loop* loop) :
+	Client(std::make_shared<net::TCPSocket>(loop), options) //, loop
+{
+}
+
+
+//
+// SSL Client
+//
+	
+
+Client* createSSLClient(const Client::Options& options, uv::Loop* loop)
+{
+	return new Client(std::make_shared<net::SSLSocket>(loop), options); //, loop);
+}
+
+
+SSLClient::SSLClient(const Client::Options& options, uv::Loop* loop) :
+	Client(std::make_shared<net::SSLSocket>(loop), options) //, loop)
+{
+}
+
+
+//
+// Client implementation
+//
+
+
+Client::Client(const net::Socket::Ptr& socket, const Client::Options& options) : //, uv::Loop* loop
+	sockio::Client(socket), //, loop
+	_options(options),
+	_announceStatus(500)
+{
+	TraceL << "Create" << endl;
+}
+
+
+Client::~Client() 
+{
+	TraceL << "Destroy" << endl;
+}
+
+
+void Client::connect()
+{
+	TraceL << "Connecting" << endl;		
+	assert(!_options.user.empty());
+	_host = _options.host;
+	_port = _options.port;
+	sockio::Client::connect();
+}
+
+
+void Client::close()
+{
+	TraceL << "Closing" << endl;
+	sockio::Client::close();
+}
+
+
+int Client::send(Message& m, bool ack)
+{	
+	if (!isOnline()) {
+		//assert(0); // may be announcing
+		throw std::runtime_error("Cannot send message while offline.");
+	}
+
+	m.setFrom(ourPeer()->address());
+	//assert(isOnline()); // may be announcing
+
+	if (m.to().id == m.from().id) {
+		assert(0);
+		throw std::runtime_error("Cannot send message with matching sender and recipient.");
+	}
+
+	if (!m.valid()) {
+		assert(0);
+		throw std::runtime_error("Cannot send invalid message.");	
+	}
+	
+#ifdef _DEBUG
+	TraceL << "Sending message: " << json::stringify(m, true) << endl;
+#endif
+	return sockio::Client::send(m, ack);
+}
+
+
+int Client::send(const std::string& data, bool ack)
+{
+	Message m;
+	if (!m.read(data))
+		throw std::runtime_error("Cannot send malformed message.");
+	return send(m, ack);
+}
+
+
+namespace internal {
+
+	std::string formatAddress(const std::string& user, const std::string& group, const std::string& id)
+		// Formats the address as Address::print() does, without a stream.
+	{
+		std::string addr(user);
+		if (!group.empty()) {
+			if (!user.empty())
+				addr += '@';
+			addr += group;
+		}
+		if (!id.empty()) {
+			addr += '/';
+			addr += id;
+		}
+		return addr;
+	}
+
+} // namespace internal
+
+
+int Client::multicast(Message& m, const Address& scope, bool ack)
+{
+	Roster::PeerList peers;
+	_roster.match(scope, peers);
+	
+	_body.clear();
+	prepareMulticast(m, _body);
+
+	std::vector<std::string> recipients;
+	recipients.reserve(peers.size());
+	for (auto peer : peers) {
+		std::string id(peer->id());
+		if (id != _ourID)
+			recipients.push_back(internal::formatAddress(peer->user(), peer->group(), id));
+	}
+	queueMulticast(_body, recipients, ack);
+	return static_cast<int>(recipients.size());
+}
+
+
+int Client::multicast(Message& m, const std::vector<Address>& addresses, bool ack)
+{
+	_body.clear();
+	prepareMulticast(m, _body);
+
+	std::vector<std::string> recipients;
+	recipients.reserve(addresses.size());
+	for (auto& addr : addresses) {
+		if (addr.id.empty() || addr.id != _ourID)
+			recipients.push_back(internal::formatAddress(addr.user, addr.group, addr.id));
+	}
+	queueMulticast(_body, recipients, ack);
+	return static_cast<int>(recipients.size());
+}
+
+
+int Client::multicast(Message& m, const std::vector<net::SocketAdapter*>& sockets)
+{
+	if (!isOnline())
+		throw std::runtime_error("Cannot send message while offline.");
+
+	m.setFrom(ourPeer()->address());
+	if (!m.valid()) {
+		assert(0);
+		throw std::runtime_error("Cannot send invalid message.");	
+	}
+
+	_body.clear();
+	json::serialize(m, _body);
+	for (auto socket : sockets)
+		socket->send(_body.data(), _body.size());
+	return static_cast<int>(sockets.size());
+}
+
+
+void Client::prepareMulticast(Message& m, Buffer& body)
+{	
+	if (!isOnline())
+		throw std::runtime_error("Cannot send message while offline.");
+
+	m.setFrom(ourPeer()->address());
+	if (!m.valid()) {
+		assert(0);
+		throw std::runtime_error("Cannot send invalid message.");	
+	}
+
+	// Serialize the message without the recipient, which is 
+	// written separately for each packet
+	json::Value to;
+	if (m.isMember("to")) {
+		to.swap(m["to"]);
+		m.removeMember("to");
+	}
+	json::serialize(m, body);
+	if (!to.isNull())
+		m["to"].swap(to);
+	assert(body.size() > 2 && body.front() == '{');
+}
+
+
+void Client::queueMulticast(const Buffer& body, const std::vector<std::string>& recipients, bool ack)
+{	
+	// Each packet is written straight into the socket.io batch, 
+	// which is flushed in a single write on the next loop iteration
+	static const char prefix[] = "{\"to\":";
+	for (auto& to : recipients) {
+		_buffer.clear();
+		sockio::Packet::writeHeader(_buffer, sockio::Packet::JSON, util::randomNumber(), ack);
+		_buffer.insert(_buffer.end(), prefix, prefix + sizeof(prefix) - 1);
+		json::serializeString(to.data(), to.size(), _buffer);
+		_buffer.push_back(',');
+		_buffer.insert(_buffer.end(), body.begin() + 1, body.end());
+		queue(_buffer.data(), _buffer.size());
+	}
+}
+
+
+int Client::respond(Message& m, bool ack)
+{
+	m.setTo(m.from());
+	return send(m, ack);
+}
+
+
+void Client::createPresence(Presence& p)
+{
+	TraceL << "Create presence" << endl;
+
+	Peer* peer = ourPeer();
+	if (peer) {
+		CreatePresence.emit(this, *peer);
+		p["data"] = *peer;
+	}
+	else assert(0 && "no session");
+}
+
+
+int Client::sendPresence(bool probe)
+{
+	TraceL << "Broadcasting presence" << endl;
+
+	Presence p;
+	createPresence(p);
+	p.setProbe(probe);
+	return send(p);
+}
+
+
+int Client::sendPresence(const Address& to, bool probe)
+{
+	TraceL << "Sending presence" << endl;
+	
+	Presence p;
+	createPresence(p);
+	p.setProbe(probe);
+	p.setTo(to);
+	return send(p);
+}
+
+	
+int Client::announce()
+{
+	TraceL << "Announcing" << endl;
+
+	json::Value data;
+	data["name"] = _options.name;
+	data["user"] = _options.user;
+	data["type"] = _options.type;
+	data["group"] = _options.group;
+	data["token"] = _options.token;
+	sockio::Packet pkt("announce", data, true);
+	auto txn = createTransaction(pkt);
+	txn->StateChange += sdelegate(this, &Client::onAnnounce);
+	return txn->send();
+}
+
+
+void Client::onAnnounce(void* sender, TransactionState& state, const TransactionState&) 
+{
+	TraceL << "On announce response: " << state << endl;
+	
+	auto transaction = reinterpret_cast<sockio::Transaction*>(sender);
+	switch (state.id()) {	
+	case TransactionState::Success:
+		try {
+			json::Value response;
+			transaction->response().json(response);
+			json::Value& data = response[(unsigned)0];
+			_announceStatus = data["status"].asInt();
+
+			if (_announceStatus != 200)
+				throw std::runtime_error(data["message"].asString());
+
+			_ourID = data["data"]["id"].asString(); //Address();
+			if (_ourID.empty())
+				throw std::runtime_error("Invalid server response.");
+
+			// Set our local peer data from the response or fail.
+			onPresenceData(data["data"], true);
+			
+			// Notify the outside application of the response 
+			// status before we transition the client state.
+			Announce.emit(this, _announceStatus);
+
+			// Transition to Online state.
+			sockio::Client::onOnline();
+
+			// Broadcast a presence probe to our network.
+			sendPresence(true);
+		}
+		catch (std::exception& exc) {
+			// Set the error message and close the connection.
+			setError("Announce failed: " + std::string(exc.what()));
+		}
+		break;		
+
+	case TransactionState::Failed:
+		Announce.emit(this, _announceStatus);
+		setError(state.message());
+		break;
+	}
+}
+
+
+void Client::onSocketConnect()
+{
+	// Start the socket.io timers etc
+	sockio::Client::onConnect();
+
+	// Authorize the symple connection	
+	announce();
+}
+
+
+void Client::onPacket(sockio::Packet& packet) 
+{
+	// Parse Symple messages from SocketIO JSON packets
+	if (packet.type() == sockio::Packet::Message || 
+		packet.type() == sockio::Packet::JSON) {	
+		//TraceL << "JSON packet: " << packet.toString() << endl;		
+
+		// Scan the top-level members to dispatch the message without
+		// building a DOM. Each message is then parsed at most once,
+		// directly into the object which is emitted.
+		const std::string& body = packet.message();
+		json::Scanner scanner(body.data(), body.size());
+		json::Scanner::Member member;
+		json::Scanner::Member type = json::Scanner::Member();
+		json::Scanner::Member from = json::Scanner::Member();
+		json::Scanner::Member data = json::Scanner::Member();
+		bool probe = false;
+		while (scanner.next(member)) {
+			if (member.is("type")) type = member;
+			else if (member.is("from")) from = member;
+			else if (member.is("data")) data = member;
+			else if (member.is("probe")) probe = member.isTrue();
+		}
+		if (scanner.error()) {
+			WarnL << "Dropping invalid packet: " << body << endl;
+			return;
+		}
+
+		if (type.equals("presence")) {
+			if (from.kind != json::Scanner::String) {
+				WarnL << "Dropping invalid presence: " << body << endl;
+				return;
+			}
+
+			// Only the peer data is used, so the rest of the 
+			// presence is never parsed.
+			if (data.kind == json::Scanner::Object) {
+				json::Value peer;
+				json::Reader reader;
+				if (!reader.parse(data.value, data.value + data.valueLength, peer, false)) {
+					WarnL << "Dropping invalid presence: " << body << endl;
+					return;
+				}
+				onPresenceData(peer, false);
+				if (probe)
+					sendPresence(Address(from.asString()));
+			}
+		}
+		else if (type.equals("message") || 
+			type.equals("event") || 
+			type.equals("command")) {
+			json::Value root;
+			json::Reader reader;
+			if (!reader.parse(body.data(), body.data() + body.size(), root, false)) {
+				WarnL << "Dropping invalid packet: " << body << endl;
+				return;
+			}
+#ifdef _DEBUG
+			TraceL << "Received message: " << type.asString() << ": " << json::stringify(root, true) << endl;
+#endif
+
+			// The message takes ownership of the parsed document.
+			if (type.equals("message")) {
+				Message m(std::move(root));
+				if (!m.valid()) {
+					WarnL << "Dropping invalid message: " << body << endl;
+					return;
+				}
+				PacketSignal::emit(this, m);
+			}
+			else if (type.equals("event")) {
+				Event e(std::move(root));
+				if (!e.valid()) {
+					WarnL << "Dropping invalid event: " << body << endl;
+					return;
+				}
+				PacketSignal::emit(this, e);
+			}
+			else {
+				Command c(std::move(root));
+				if (!c.valid()) {
+					WarnL << "Dropping invalid command: " << body << endl;
+					return;
+				}
+				PacketSignal::emit(this, c);
+				if (c.isRequest()) {
+					c.setStatus(404);
+					WarnL << "Command not handled: " << c.id() << ": " << c.node() << endl;
+					respond(c);
+				}
+			}
+		}
+		else
+			WarnL << "Received non-standard message: " << type.asString() << endl;
+	}
+
+	// Other packet types are proxied directly
+	else {		
+		TraceL << "Proxying packet" << endl;		
+		PacketSignal::emit(this, packet);
+	}
+}
+
+
+void Client::onPresenceData(const json::Value& data, bool whiny)
+{
+	//TraceL << "Updating: " << json::stringify(data, true) << endl;
+
+	if (data.isObject() &&
+		data.isMember("id") && 
+		data.isMember("user") && 
+		data.isMember("name") && 
+		data.isMember("online") //&& 
+		//data.isMember("type") 
+		) {
+		std::string id = data["id"].asString();
+		bool online = data["online"].asBool();
+		Peer* peer = _roster.get(id, false);
+		if (online) {
+			if (!peer) {
+				peer = new Peer(data);
+				_roster.add(id, peer);
+				InfoL << "Peer connected: " << peer->address().toString() << endl;
+				PeerConnected.emit(this, *peer);
+			} 
+			else
+				_roster.update(id, data);
+		}
+		else {
+			if (peer) {
+				InfoL << "Peer disconnected: " << peer->address().toString() << endl;
+				PeerDisconnected.emit(this, *peer);
+				_roster.free(id);
+			}
+			else {
+				WarnL << "Got peer disconnected for unknown peer: " << id << endl;
+			}
+		}
+	}
+	else {
+		std::string error("Bad presence data: " + json::stringify(data));
+		ErrorL << error << endl;	
+		if (whiny)
+			throw std::runtime_error(error);
+	}
+
+#if 0
+	if (data.isObject() &&
+		data.isMember("id") && 
+		data.isMember("user") && 
+		data.isMember("name") //&& 
+		//data.isMember("type")
+		) {
+		TraceL << "Updating: " << json::stringify(data, true) << endl;
+		std::string id = data["id"].asString();
+		Peer* peer = get(id, false);
+		if (!peer) {
+			peer = new Peer(data);
+			add(id, peer);
+		} else
+			static_cast<json::Value&>(*peer) = data;
+	}
+	else if (data.isArray()) {
+		for (auto it = data.begin(); it != data.end(); it++) {
+			onPresenceData(*it, whiny);	
+		}
+	}
+	else {
+		std::string error("Bad presence data: " + json::stringify(data));
+		ErrorL << error << endl;	
+		if (whiny)
+			throw std::runtime_error(error);
+	}
+#endif
+}
+
+
+void Client::reset()
+{
+	// Note: Not clearing persisted messages just in case
+	// they are still in use by the outside application
+	//_persistence.clear();
+
+	_roster.clear();
+	_announceStatus = 500;
+	_ourID = "";
+	sockio::Client::reset();
+}
+
+
+Roster& Client::roster() 
+{ 
+	//Mutex::ScopedLock lock(_mutex);
+	return _roster; 
+}
+
+
+PersistenceT& Client::persistence() 
+{ 
+	//Mutex::ScopedLock lock(_mutex);
+	return _persistence; 
+}
+
+
+Client::Options& Client::options() 
+{ 
+	//Mutex::ScopedLock lock(_mutex);
+	return _options; 
+}
+
+
+std::string Client::ourID() const
+{
+	//Mutex::ScopedLock lock(_mutex);
+	return _ourID;
+}
+
+
+Peer* Client::ourPeer()
+{	
+	//Mutex::ScopedLock lock(_mutex);
+	if (_ourID.empty())
+		return nullptr;
+		//throw std::runtime_error("No active peer session is available.");
+	return _roster.get(_ourID, false);
+}
+
+
+Client& Client::operator >> (Message& message)
+{
+	send(message);
+	return *this;
+}
+
+
+} } // namespace scy::smpl
\ No newline at end of file
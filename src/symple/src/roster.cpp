@@ -0,0 +1,389 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "scy/symple/roster.h"
+#include "scy/logger.h"
+#include "assert.h"
+
+#include <cstring>
+
+
+using std::endl;
+
+
+namespace scy {
+namespace smpl {
+
+
+Roster::Roster()
+{	
+	//TraceLS(this) << "Create" << endl;
+}
+	
+
+Roster::~Roster() 
+{
+	//TraceLS(this) << "Destroy" << endl;
+}
+
+
+namespace internal {
+
+	inline const char* stringMember(const json::Value& value, const char* name)
+		// Returns the string member without copying it, or an 
+		// empty string if it is missing or not a string.
+	{
+		const json::Value& member = value[name];
+		const char* str = member.isString() ? member.asCString() : nullptr;
+		return str ? str : "";
+	}
+
+} // namespace internal
+
+
+bool Roster::add(const std::string& id, Peer* peer, bool whiny)
+{
+	{
+		Mutex::ScopedLock lock(_mutex);
+		if (_index.find(id) != _index.end()) {
+			if (whiny)
+				throw std::runtime_error("Item already exists");
+			return false;
+		}
+		_map[id] = peer;
+		index(id, peer);
+	}
+	onAdd(id, peer);
+	return true;
+}
+
+
+void Roster::update(const std::string& id, Peer* peer)
+{
+	// Note: This method will not delete existing values.
+	{
+		Mutex::ScopedLock lock(_mutex);
+		_map[id] = peer;
+		auto it = _index.find(id);
+		if (it != _index.end())
+			unindex(it);
+		index(id, peer);
+	}
+	onAdd(id, peer);
+}
+
+
+bool Roster::update(const std::string& id, const json::Value& data)
+{
+	Mutex::ScopedLock lock(_mutex);
+	auto it = _index.find(id);
+	if (it == _index.end())
+		return false;
+
+	Entry& entry = it->second;
+	json::Value& peer = *entry.peer;
+
+	// Members are stored in key order, so both objects are walked 
+	// in a single merge pass. Only changed members are assigned, and
+	// members which are no longer present are removed afterwards.
+	std::vector<std::string> stale;
+	auto current = peer.begin();
+	auto member = data.begin();
+	while (current != peer.end() || member != data.end()) {
+		int cmp = current == peer.end() ? 1 : member == data.end() ? -1 :
+			std::strcmp(current.memberName(), member.memberName());
+		if (cmp < 0) {
+			stale.push_back(current.memberName());
+			++current;
+		}
+		else if (cmp > 0) {
+			peer[member.memberName()] = *member;
+			++member;
+		}
+		else {
+			if (*current != *member)
+				*current = *member;
+			++current;
+			++member;
+		}
+	}
+	for (auto& name : stale)
+		peer.removeMember(name);
+
+	// Move the entry between lists if its user or group changed
+	const char* user = internal::stringMember(peer, "user");
+	if (entry.user != user) {
+		unlink(_users, entry.user, &entry, &Entry::userSlot);
+		entry.user = user;
+		link(_users, entry.user, &entry, &Entry::userSlot);
+	}
+	const char* group = internal::stringMember(peer, "group");
+	if (entry.group != group) {
+		unlink(_groups, entry.group, &entry, &Entry::groupSlot);
+		entry.group = group;
+		link(_groups, entry.group, &entry, &Entry::groupSlot);
+	}
+	return true;
+}
+
+
+Peer* Roster::get(const std::string& id, bool whiny) const
+{
+	Mutex::ScopedLock lock(_mutex); 
+	auto it = _index.find(id);
+	if (it != _index.end())
+		return it->second.peer;
+	if (whiny)
+		throw std::runtime_error("Item not found");
+	return nullptr;
+}
+
+
+Peer* Roster::remove(const std::string& id)
+{
+	Peer* peer = nullptr;
+	{
+		Mutex::ScopedLock lock(_mutex);
+		auto it = _index.find(id);
+		if (it != _index.end()) {
+			peer = it->second.peer;
+			unindex(it);
+			_map.erase(id);
+		}
+	}
+	if (peer)
+		onRemove(id, peer);
+	return peer;
+}
+
+
+bool Roster::remove(const Peer* peer)
+{
+	std::string id;
+	Peer* ptr = nullptr;
+	{
+		Mutex::ScopedLock lock(_mutex);
+		for (auto it = _map.begin(); it != _map.end(); ++it) {
+			if (it->second == peer) {
+				id = it->first;
+				ptr = it->second;
+				_map.erase(it);
+				unindex(_index.find(id));
+				break;
+			}
+		}
+	}
+	if (ptr)
+		onRemove(id, ptr);
+	return ptr != nullptr;
+}
+
+
+bool Roster::exists(const std::string& id) const
+{
+	Mutex::ScopedLock lock(_mutex); 
+	return _index.find(id) != _index.end();
+}
+
+
+bool Roster::exists(const Peer* peer) const
+{
+	return Manager::exists(peer);
+}
+
+
+void Roster::clear()
+{
+	{
+		Mutex::ScopedLock lock(_mutex); 
+		_index.clear();
+		_users.clear();
+		_groups.clear();
+	}
+	Manager::clear();
+}
+
+
+Peer* Roster::getByHost(const std::string& host)
+{
+	Mutex::ScopedLock lock(_mutex);
+	for (auto it = _index.begin(); it != _index.end(); ++it) {	
+		if (host == internal::stringMember(*it->second.peer, "host"))
+			return it->second.peer;
+	}
+	return NULL;
+}
+
+
+Roster::PeerList Roster::byUser(const std::string& user) const
+{
+	PeerList peers;
+	Mutex::ScopedLock lock(_mutex);
+	auto it = _users.find(user);
+	if (it != _users.end()) {
+		peers.reserve(it->second.size());
+		for (auto entry : it->second)
+			peers.push_back(entry->peer);
+	}
+	return peers;
+}
+
+
+Roster::PeerList Roster::byGroup(const std::string& group) const
+{
+	PeerList peers;
+	Mutex::ScopedLock lock(_mutex);
+	auto it = _groups.find(group);
+	if (it != _groups.end()) {
+		peers.reserve(it->second.size());
+		for (auto entry : it->second)
+			peers.push_back(entry->peer);
+	}
+	return peers;
+}
+
+
+void Roster::match(const Address& address, PeerList& peers) const
+{
+	Mutex::ScopedLock lock(_mutex);
+	if (!address.id.empty()) {
+		auto it = _index.find(address.id);
+		if (it != _index.end() &&
+			(address.user.empty() || it->second.user == address.user) &&
+			(address.group.empty() || it->second.group == address.group))
+			peers.push_back(it->second.peer);
+	}
+	else if (!address.user.empty()) {
+		auto it = _users.find(address.user);
+		if (it != _users.end()) {
+			for (auto entry : it->second) {
+				if (address.group.empty() || entry->group == address.group)
+					peers.push_back(entry->peer);
+			}
+		}
+	}
+	else if (!address.group.empty()) {
+		auto it = _groups.find(address.group);
+		if (it != _groups.end()) {
+			for (auto entry : it->second)
+				peers.push_back(entry->peer);
+		}
+	}
+}
+
+
+void Roster::index(const std::string& id, Peer* peer)
+{
+	Entry& entry = _index[id];
+	entry.peer = peer;
+	entry.user = internal::stringMember(*peer, "user");
+	entry.group = internal::stringMember(*peer, "group");
+	link(_users, entry.user, &entry, &Entry::userSlot);
+	link(_groups, entry.group, &entry, &Entry::groupSlot);
+}
+
+
+void Roster::unindex(Index::iterator it)
+{
+	if (it == _index.end())
+		return;
+	Entry& entry = it->second;
+	unlink(_users, entry.user, &entry, &Entry::userSlot);
+	unlink(_groups, entry.group, &entry, &Entry::groupSlot);
+	_index.erase(it);
+}
+
+
+void Roster::link(SecondaryIndex& index, const std::string& key, Entry* entry, std::size_t Entry::*slot)
+{
+	auto& list = index[key];
+	entry->*slot = list.size();
+	list.push_back(entry);
+}
+
+
+void Roster::unlink(SecondaryIndex& index, const std::string& key, Entry* entry, std::size_t Entry::*slot)
+{
+	// Swap the last entry into the removed slot
+	auto it = index.find(key);
+	assert(it != index.end());
+	auto& list = it->second;
+	std::size_t pos = entry->*slot;
+	assert(pos < list.size() && list[pos] == entry);
+	list[pos] = list.back();
+	list[pos]->*slot = pos;
+	list.pop_back();
+	if (list.empty())
+		index.erase(it);
+}
+
+
+Roster::PeerMap Roster::peers() const 
+{ 
+	Mutex::ScopedLock lock(_mutex);
+	return _map; 
+}
+
+
+void Roster::print(std::ostream& os) const
+{
+	Mutex::ScopedLock lock(_mutex);
+
+	os << "Roster[";
+	for (auto it = _map.begin(); it != _map.end(); ++it) {	
+		os << "\n\t" << it->second << ": " << it->first;
+	}
+	os << "\n]";
+}
+
+
+#if 0
+void Roster::update(const json::Value& data, bool whiny)
+{
+	if (data.isObject() &&
+		data.isMember("id") && 
+		data.isMember("user") && 
+		data.isMember("name") //&& 
+		//data.isMember("type")
+		) {
+		TraceLS(this) << "Updating: " << json::stringify(data, true) << endl;
+		std::string id = data["id"].asString();
+		Peer* peer = get(id, false);
+		if (!peer) {
+			peer = new Peer(data);
+			add(id, peer);
+		} else
+			static_cast<json::Value&>(*peer) = data;
+	}
+	else if (data.isArray()) {
+		for (auto it = data.begin(); it != data.end(); it++) {
+			update(*it, whiny);	
+		}
+	}
+	else {
+		std::string error("Bad presence data: " + json::stringify(data));
+		ErrorLS(this) << error << endl;	
+		if (whiny)
+			throw std::runtime_error(error);
+	}
+}
+#endif
+
+
+} } // namespace scy::smpl
\ No newline at end of file
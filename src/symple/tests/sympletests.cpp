@@ -0,0 +1,508 @@
+#include "scy/application.h"
+#include "scy/symple/client.h"
+#include "scy/net/sslmanager.h"
+#include "scy/util.h"
+
+#include <algorithm>
+
+
+using namespace std;
+using namespace scy;
+using namespace scy::net;
+using namespace scy::util;
+
+
+/*
+// Detect Memory Leaks
+#ifdef _DEBUG
+#include "MemLeakDetect/MemLeakDetect.h"
+#include "MemLeakDetect/MemLeakDetect.cpp"
+CMemLeakDetect memLeakDetect;
+#endif
+*/
+
+
+namespace scy {
+namespace smpl {
+
+	
+#define SERVER_HOST "localhost" //"anionu.com" //
+#define USE_SSL     1
+#if USE_SSL
+#define SERVER_PORT 443
+#else
+#define SERVER_PORT 4000 
+#endif
+
+	
+// ----------------------------------------------------------------------------
+// SocketIO Client Test
+//		
+class Tests
+{
+	Application app;
+	
+public:
+	Tests()
+	{	
+		// TODO: 
+		//  - Obtain authentication token
+		//  - Transaction test
+		//  - Presence test
+		//  - Ack test
+		//  - Benchmarks
+		testRoster();
+		testMulticast();
+		testClient();
+#if 0
+		testAddress();
+		benchmarkRoster();
+		benchmarkPresenceBroadcast();
+#endif
+	}
+
+	~Tests()
+	{
+		app.finalize();
+	}
+	
+	void testAddress() 
+	{
+		smpl::Address a("user@group/567257247245275");
+		assert(a.user == "user");
+		assert(a.group == "group");
+		assert(a.id == "567257247245275");
+		assert(a.valid());
+
+		smpl::Address a1("user@group");
+		assert(a1.user == "user");
+		assert(a1.group == "group");
+		assert(a1.id == "");
+		assert(a1.valid());
+
+		smpl::Address a2("group");
+		assert(a2.user == "");
+		assert(a2.group == "group");
+		assert(a2.id == "");
+		assert(a2.valid());
+
+		smpl::Address a3("");
+		assert(a3.user == "");
+		assert(a3.group == "");
+		assert(a3.id == "");
+		assert(!a3.valid());
+
+		smpl::Address a4("/567257247245275");
+		assert(a4.user == "");
+		assert(a4.group == "");
+		assert(a4.id == "567257247245275");
+		assert(a4.valid());
+
+		smpl::Address a5("group/567257247245275");
+		assert(a5.user == "");
+		assert(a5.group == "group");
+		assert(a5.id == "567257247245275");
+		assert(a5.valid());
+	}
+
+	static std::string peerIDs(const smpl::Roster::PeerList& peers)
+		// Returns the sorted IDs of the peers, joined by commas.
+	{
+		std::vector<std::string> ids;
+		for (auto peer : peers)
+			ids.push_back(peer->id());
+		std::sort(ids.begin(), ids.end());
+		std::string out;
+		for (auto& id : ids)
+			out += (out.empty() ? "" : ",") + id;
+		return out;
+	}
+
+	static std::string matchIDs(const smpl::Roster& roster, const smpl::Address& address)
+	{
+		smpl::Roster::PeerList peers;
+		roster.match(address, peers);
+		return peerIDs(peers);
+	}
+
+	static json::Value createPeerData(const std::string& id, const std::string& user, const std::string& group)
+	{
+		json::Value data;
+		data["id"] = id;
+		data["user"] = user;
+		data["group"] = group;
+		data["name"] = "Peer " + id;
+		data["online"] = true;
+		return data;
+	}
+
+	void testRoster() 
+	{
+		smpl::Roster roster;
+		roster.add("a", new smpl::Peer(createPeerData("a", "u1", "g1")));
+		roster.add("b", new smpl::Peer(createPeerData("b", "u1", "g1")));
+		roster.add("c", new smpl::Peer(createPeerData("c", "u2", "g1")));
+		roster.add("d", new smpl::Peer(createPeerData("d", "u3", "g2")));
+		assert(peerIDs(roster.byUser("u1")) == "a,b");
+		assert(peerIDs(roster.byGroup("g1")) == "a,b,c");
+		assert(peerIDs(roster.byGroup("g2")) == "d");
+		assert(roster.byUser("nobody").empty());
+
+		// Move a peer to another user
+		assert(roster.update("a", createPeerData("a", "u2", "g1")));
+		assert(peerIDs(roster.byUser("u1")) == "b");
+		assert(peerIDs(roster.byUser("u2")) == "a,c");
+		assert(peerIDs(roster.byGroup("g1")) == "a,b,c");
+		assert(roster.get("a")->user() == "u2");
+
+		// Move a peer to another group
+		assert(roster.update("b", createPeerData("b", "u1", "g2")));
+		assert(peerIDs(roster.byGroup("g1")) == "a,c");
+		assert(peerIDs(roster.byGroup("g2")) == "b,d");
+
+		// Move a peer to another user and group at once, 
+		// emptying the lists it leaves
+		assert(roster.update("d", createPeerData("d", "u1", "g3")));
+		assert(roster.byUser("u3").empty());
+		assert(peerIDs(roster.byUser("u1")) == "b,d");
+		assert(peerIDs(roster.byGroup("g2")) == "b");
+		assert(peerIDs(roster.byGroup("g3")) == "d");
+
+		// Members which are no longer present are removed, and a 
+		// missing group moves the peer to the empty group
+		json::Value data = createPeerData("b", "u1", "g2");
+		data.removeMember("group");
+		data.removeMember("online");
+		data["status"] = "away";
+		assert(roster.update("b", data));
+		smpl::Peer* b = roster.get("b");
+		assert(!b->isMember("group"));
+		assert(!b->isMember("online"));
+		assert((*b)["status"].asString() == "away");
+		assert((*b)["name"].asString() == "Peer b");
+		assert(roster.byGroup("g2").empty());
+		assert(peerIDs(roster.byGroup("")) == "b");
+
+		// Unchanged data leaves the indexes alone
+		assert(roster.update("c", createPeerData("c", "u2", "g1")));
+		assert(peerIDs(roster.byUser("u2")) == "a,c");
+		assert(!roster.update("missing", data));
+
+		// Address matching: by ID, user within group, user in 
+		// any group, and group
+		assert(matchIDs(roster, smpl::Address("/a")) == "a");
+		assert(matchIDs(roster, smpl::Address("u2", "g1", "a")) == "a");
+		assert(matchIDs(roster, smpl::Address("u1", "", "a")) == "");
+		assert(matchIDs(roster, smpl::Address("u2@g1")) == "a,c");
+		assert(matchIDs(roster, smpl::Address("u1@g3")) == "d");
+		assert(matchIDs(roster, smpl::Address("u1", "", "")) == "b,d");
+		assert(matchIDs(roster, smpl::Address("g1")) == "a,c");
+		assert(matchIDs(roster, smpl::Address("g9")) == "");
+
+		// Removing a member from the middle of a list swaps the 
+		// last member into its slot
+		for (int i = 0; i < 8; i++) {
+			std::string id("e" + util::itostr(i));
+			roster.add(id, new smpl::Peer(createPeerData(id, "u4", "g1")));
+		}
+		assert(roster.byGroup("g1").size() == 10);
+		assert(roster.free("e2"));
+		assert(roster.free("a"));
+		assert(roster.free("e7"));
+		smpl::Peer* e0 = roster.get("e0");
+		assert(roster.remove(e0));
+		delete e0;
+		assert(matchIDs(roster, smpl::Address("g1")) == "c,e1,e3,e4,e5,e6");
+		assert(matchIDs(roster, smpl::Address("u4@g1")) == "e1,e3,e4,e5,e6");
+		assert(peerIDs(roster.byUser("u2")) == "c");
+		assert(roster.update("e4", createPeerData("e4", "u2", "g2")));
+		assert(matchIDs(roster, smpl::Address("u4@g1")) == "e1,e3,e5,e6");
+		assert(matchIDs(roster, smpl::Address("u2", "", "")) == "c,e4");
+		assert(matchIDs(roster, smpl::Address("g2")) == "e4");
+
+		// Replacing a peer reindexes it, and leaves the old one to the caller
+		smpl::Peer* c = roster.get("c");
+		roster.update("c", new smpl::Peer(createPeerData("c", "u5", "g2")));
+		delete c;
+		assert(roster.byUser("u2").size() == 1);
+		assert(matchIDs(roster, smpl::Address("g2")) == "c,e4");
+		assert(!roster.get("missing", false));
+	}
+
+	static json::Value createPresenceData(int i)
+	{
+		json::Value data;
+		data["id"] = util::itostr(i);
+		data["user"] = "user" + util::itostr(i % 5000);
+		data["group"] = "group" + util::itostr(i % 50);
+		data["name"] = "Peer " + util::itostr(i);
+		data["type"] = "Peer";
+		data["host"] = "10.0." + util::itostr((i / 250) % 250) + "." + util::itostr(i % 250);
+		data["online"] = true;
+		data["status"] = "available";
+		data["features"]["video"] = true;
+		data["features"]["audio"] = true;
+		return data;
+	}
+
+	void benchmarkRoster() 
+	{
+		// Measures roster churn with 50k peers: most presence updates 
+		// change a single member, and a fraction of peers disconnect 
+		// and are replaced. Group fan-out is measured separately.
+		const int numPeers = 50000;
+		const int iterations = 500000;
+
+		std::vector<json::Value> presence;
+		for (int i = 0; i < numPeers * 2; i++)
+			presence.push_back(createPresenceData(i));
+
+		smpl::Roster roster;
+		UInt64 start = uv_hrtime();
+		for (int i = 0; i < numPeers; i++)
+			roster.add(presence[i]["id"].asString(), new smpl::Peer(presence[i]));
+		UInt64 elapsed = uv_hrtime() - start;
+		cout << "Roster: added " << numPeers << " peers in " 
+			<< (elapsed / 1000000) << "ms" << endl;
+
+		int next = numPeers;
+		start = uv_hrtime();
+		for (int i = 0; i < iterations; i++) {
+			int n = static_cast<int>((UInt64(i) * 7919) % next);
+			json::Value& data = presence[n];
+			std::string id(data["id"].asString());
+			if (i % 10 == 0) {
+				// Disconnect and replace with a new peer
+				if (roster.free(id)) {
+					json::Value& added = presence[next++ % presence.size()];
+					roster.add(added["id"].asString(), new smpl::Peer(added));
+				}
+			}
+			else {
+				data["status"] = i % 2 ? "away" : "available";
+				roster.update(id, data);
+			}
+		}
+		elapsed = uv_hrtime() - start;
+		cout << "Roster: " << iterations << " updates with churn in " 
+			<< (elapsed / 1000000) << "ms: " 
+			<< (double(elapsed) / iterations) << "ns/update" << endl;
+
+		smpl::Roster::PeerList peers;
+		start = uv_hrtime();
+		for (int i = 0; i < 1000; i++) {
+			peers.clear();
+			roster.match(smpl::Address("group" + util::itostr(i % 50)), peers);
+		}
+		elapsed = uv_hrtime() - start;
+		cout << "Roster: group fan-out of " << peers.size() << " peers: " 
+			<< (double(elapsed) / 1000) << "ns/match" << endl;
+	}
+
+	class MulticastClient: public smpl::TCPClient
+		/// Captures the queued socket.io packets rather than 
+		/// writing them, so no server is needed.
+	{
+	public:
+		std::vector<std::string> packets;
+
+		MulticastClient(uv::Loop* loop) : 
+			smpl::TCPClient(smpl::Client::Options(), loop) 
+		{
+		}
+
+		void goOnline(const json::Value& data)
+		{
+			_ourID = data["id"].asString();
+			_roster.add(_ourID, new smpl::Peer(data));
+			sockio::Client::onOnline();
+		}
+
+	protected:
+		int queue(const char* data, std::size_t len)
+		{
+			packets.push_back(std::string(data, len));
+			return static_cast<int>(len);
+		}
+	};
+
+	static smpl::Message readPacket(const std::string& data)
+		// Parses a captured packet as the receiving client would.
+	{
+		sockio::Packet packet;
+		std::size_t nread = packet.read(constBuffer(data.data(), data.size()));
+		assert(nread == data.size());
+		assert(packet.type() == sockio::Packet::JSON);
+		json::Value root;
+		bool parsed = packet.json(root);
+		assert(parsed);
+		return smpl::Message(root);
+	}
+
+	void benchmarkPresenceBroadcast() 
+	{
+		// Measures the outgoing presence path: building the presence 
+		// message, serializing it and framing the socket.io packet.
+		// Packets are captured rather than written to a socket.
+		const int iterations = 200000;
+
+		MulticastClient client(app.loop);
+		client.goOnline(createPresenceData(1));
+
+		std::size_t bytes = 0;
+		UInt64 start = uv_hrtime();
+		for (int i = 0; i < iterations; i++) {
+			client.sendPresence();
+			bytes += client.packets.back().size();
+			client.packets.clear();
+		}
+		UInt64 elapsed = uv_hrtime() - start;
+		cout << "Presence broadcast: " << iterations << " messages in " 
+			<< (elapsed / 1000000) << "ms: " 
+			<< (iterations * 1e9 / elapsed) << " msg/s, "
+			<< (bytes / iterations) << " bytes/msg" << endl;
+	}
+
+	void testMulticast() 
+	{
+		MulticastClient client(app.loop);
+		client.roster().add("b", new smpl::Peer(createPeerData("b", "u2", "g1")));
+		client.roster().add("c", new smpl::Peer(createPeerData("c", "u3", "g1")));
+		client.roster().add("d", new smpl::Peer(createPeerData("d", "u4", "g2")));
+		client.goOnline(createPeerData("a", "u1", "g1"));
+
+		smpl::Message m;
+		m["data"]["text"] = "hello \"quoted\" world";
+		m["data"]["list"].append(1);
+		m["data"]["list"].append(2);
+		m.setTo(smpl::Address("u9@g9/zz")); // replaced for each recipient
+
+		// An ordinary send in the same iteration must stay ahead 
+		// of the multicast, since they share the same batch
+		smpl::Message direct;
+		direct.setTo(smpl::Address("u4@g2/d"));
+		int sent = client.send(direct);
+		assert(sent > 0);
+
+		// Roster scope, skipping ourselves
+		int count = client.multicast(m, smpl::Address("g1"));
+		assert(count == 2);
+
+		// Explicit recipients, skipping ourselves
+		std::vector<smpl::Address> recipients;
+		recipients.push_back(smpl::Address("u1@g1/a"));
+		recipients.push_back(smpl::Address("u4@g2/d"));
+		recipients.push_back(smpl::Address("u5@g3"));
+		count = client.multicast(m, recipients);
+		assert(count == 2);
+
+		assert(client.packets.size() == 5);
+		smpl::Message first(readPacket(client.packets[0]));
+		assert(first.id() == direct.id());
+
+		std::vector<std::string> to;
+		for (std::size_t i = 1; i < client.packets.size(); i++) {
+			smpl::Message received(readPacket(client.packets[i]));
+			to.push_back(received.to().toString());
+			assert(received.from().toString() == "u1@g1/a");
+			assert(received.id() == m.id());
+			assert(received.type() == "message");
+			assert(received["data"] == m["data"]);
+			assert(received.getMemberNames() == m.getMemberNames());
+		}
+		std::sort(to.begin(), to.begin() + 2);
+		assert(to[0] == "u2@g1/b");
+		assert(to[1] == "u3@g1/c");
+		assert(to[2] == "u4@g2/d");
+		assert(to[3] == "u5@g3");
+
+		// The message itself is unchanged
+		assert(m.to().toString() == "u9@g9/zz");
+		client.packets.clear();
+	}
+
+	void testClient() 
+	{
+		smpl::Client::Options options;
+		options.host = SERVER_HOST;
+		options.port = SERVER_PORT;
+		options.user = "test";
+		options.group = "global";
+		options.name = "crash";
+		options.type = "testapp";
+
+		// NOTE: The server should use anonymous 
+		// authentication for this test.
+		//options.token = ""; used for authentication
+	
+#if USE_SSL
+		smpl::SSLClient client(options); //reactor, runner, 
+#else
+		smpl::TCPClient client(options); //reactor, runner, 
+#endif
+		
+		client.StateChange += sdelegate(this, &Tests::onClientStateChange);
+		client.CreatePresence += sdelegate(this, &Tests::onCreatePresence);
+		client.connect();
+
+		app.waitForShutdown([](void* opaque) {
+			reinterpret_cast<smpl::Client*>(opaque)->close();
+		}, &client);
+
+		DebugL << "Event loop ended" << endl;
+	}
+
+	void onClientStateChange(void* sender, sockio::ClientState& state, const sockio::ClientState& oldState) 
+	{
+		smpl::Client* client = reinterpret_cast<smpl::Client*>(sender);	
+		DebugL << "Client state changed: " << state << ": " << client->ws().socket->address() << endl;
+		
+		switch (state.id()) {
+		case sockio::ClientState::Connecting:
+			break;
+		case sockio::ClientState::Connected: 
+			break;
+		case sockio::ClientState::Online: 
+			break;
+		case sockio::ClientState::Error:
+			assert(0);
+			break;
+		}
+	}
+	
+	void onCreatePresence(void*, smpl::Peer& peer)
+	{
+		DebugL << "Updating Client Data" << endl;
+		
+		// Update the peer object to be broadcast with presence.
+		// Any arbitrary data can be broadcast with presence.
+		peer["agent"] = "Spot";
+		peer["version"] = "1.0.1";
+	}
+};
+
+
+} } // namespace scy::smpl
+
+
+int main(int argc, char** argv) 
+{	
+	Logger::instance().add(new ConsoleChannel("debug", LTrace));
+	
+#if USE_SSL
+	// Init SSL Context
+	SSLContext::Ptr ptrContext = new SSLContext(SSLContext::CLIENT_USE, "", "", "",
+		SSLContext::VERIFY_NONE, 9, true, "ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH");	
+	SSLManager::instance().initializeClient(ptrContext);
+#endif	
+
+	{
+		scy::smpl::Tests run;
+	}		
+		
+#if USE_SSL
+	SSLManager::instance().shutdown();
+#endif	
+	Logger::destroy();
+	return 0;
+}
\ No newline at end of file
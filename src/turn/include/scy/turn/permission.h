@@ -0,0 +1,77 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef SCY_TURN_Permission_H
+#define SCY_TURN_Permission_H
+
+
+#include "scy/turn/fivetuple.h"
+#include "scy/timer.h"
+#include "scy/net/address.h"
+
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+
+
+namespace scy {
+namespace turn {
+
+
+// The Permission Lifetime MUST be 300 seconds (= 5 minutes).
+const int PERMISSION_LIFETIME = 3 * 60 * 1000;
+
+
+struct Permission 
+{
+	std::string ip;
+	UInt64 expiresAt;
+		// The loop time in milliseconds when the permission expires.
+
+	Permission(const std::string& ip) : 
+		ip(ip)
+	{
+		refresh();
+	}
+
+	void refresh()
+	{
+		expiresAt = uv_now(uv::defaultLoop()) + PERMISSION_LIFETIME;
+	}
+
+	bool expired(UInt64 now) const
+	{
+		return now >= expiresAt;
+	}
+
+	bool operator ==(const std::string& r) const
+	{
+		return ip == r;
+	}
+};
+
+
+typedef std::vector<Permission> PermissionList;
+
+
+} } // namespace scy::turn
+
+
+#endif // SCY_TURN_Permission_H
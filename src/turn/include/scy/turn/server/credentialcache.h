@@ -0,0 +1,125 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#ifndef SCY_TURN_CredentialCache_H
+#define SCY_TURN_CredentialCache_H
+
+
+#include "scy/uv/uvpp.h"
+#include "scy/types.h"
+
+#include <string>
+#include <list>
+#include <map>
+
+
+namespace scy {
+namespace turn {
+
+
+class CredentialCache
+	/// CredentialCache remembers the long-term credential key, 
+	/// MD5(username:realm:password), derived for each username and 
+	/// realm, along with the nonce it was last authenticated with.
+	///
+	/// Requests which carry a cached nonce can be verified against the
+	/// cached key without asking the ServerObserver to derive it again.
+	/// Entries expire after a fixed lifetime, and the least recently
+	/// used entries are evicted once the size limit is reached.
+	///
+	/// The cache is not thread-safe and must be used from the thread
+	/// running its event loop.
+{
+public:
+	struct Stats
+	{
+		UInt64 hits;
+		UInt64 misses;
+		UInt64 evicted;
+
+		Stats() : hits(0), misses(0), evicted(0) {}
+
+		double hitRate() const 
+		{
+			return (hits + misses) ? double(hits) / (hits + misses) : 0;
+		}
+	};
+
+	CredentialCache(uv::Loop* loop = uv::defaultLoop(), 
+		std::size_t limit = 1024, Int64 ttl = 10 * 60 * 1000);
+	virtual ~CredentialCache();
+	
+	bool find(const std::string& username, const std::string& realm, 
+		const std::string& nonce, std::string& key);
+		// Sets the cached key for the given username and realm if a 
+		// fresh entry exists which was authenticated with the given nonce.
+		// Returns false and counts a miss otherwise.
+
+	void store(const std::string& username, const std::string& realm, 
+		const std::string& nonce, const std::string& key);
+		// Caches the key and nonce a request was authenticated with.
+		// Storing with a zero size limit does nothing.
+
+	void invalidate(const std::string& username, const std::string& realm);
+		// Drops the cached entry for the given username and realm.
+		// Call this when a user's password changes.
+
+	void clear();
+		// Drops all cached entries.
+
+	void setLimit(std::size_t limit);
+		// Sets the maximum number of cached entries.
+		// A limit of zero disables caching.
+
+	void setTTL(Int64 ttl);
+		// Sets the lifetime of new entries in milliseconds.
+
+	std::size_t size() const;
+		// Returns the number of cached entries.
+
+	const Stats& stats() const;
+		// Returns the cache hit and miss counters.
+
+protected:
+	struct Entry
+	{
+		std::string key;
+		std::string nonce;
+		std::list<std::string>::iterator lru;
+		Int64 expires;
+	};
+
+	void prune();
+	
+	typedef std::map<std::string, Entry> EntryMap;
+	
+	uv::Loop* _loop;
+	std::size_t _limit;
+	Int64 _ttl;
+	EntryMap _entries;
+	std::list<std::string> _lru;
+	Stats _stats;
+};
+
+
+} } //  namespace scy::turn
+
+
+#endif // SCY_TURN_CredentialCache_H
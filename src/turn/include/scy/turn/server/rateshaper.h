@@ -0,0 +1,135 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#ifndef SCY_TURN_RateShaper_H
+#define SCY_TURN_RateShaper_H
+
+
+#include "scy/types.h"
+
+#include <cstddef>
+
+
+namespace scy {
+namespace turn {
+
+
+struct ShapingOptions 
+	/// Rate shaping options for relayed data.
+	/// A zero rate disables the corresponding limit.
+{
+	enum Policy
+	{
+		Drop,	// Discard data which exceeds the rate
+		Queue	// Delay data until the rate allows it
+	};
+
+	UInt64 bytesPerSecond;
+	UInt64 packetsPerSecond;
+	UInt64 burstBytes;       // Bucket depth, one second of traffic if zero
+	UInt64 burstPackets;     // Bucket depth, one second of traffic if zero
+	Policy policy;
+	std::size_t maxQueueSize; // Maximum bytes queued per allocation
+
+	ShapingOptions() {
+		bytesPerSecond						= 0;
+		packetsPerSecond					= 0;
+		burstBytes							= 0;
+		burstPackets						= 0;
+		policy								= Drop;
+		maxQueueSize						= 256 * 1024;
+	}
+
+	bool enabled() const { return bytesPerSecond > 0 || packetsPerSecond > 0; }
+};
+
+
+class TokenBucket
+	/// An integer token bucket refilled from a millisecond clock.
+	///
+	/// The clock is passed in by the caller, which is expected to use
+	/// the event loop's cached time so accounting costs no system calls.
+	/// Fractional tokens are carried between refills so slow rates are 
+	/// not rounded away. The bucket may go into debt when tokens are
+	/// consumed unconditionally.
+{
+public:
+	TokenBucket(UInt64 rate = 0, UInt64 burst = 0, UInt64 now = 0);
+		// Creates a bucket refilled with rate tokens per second, holding 
+		// at most burst tokens. A zero burst holds one second of tokens.
+		// The bucket starts full.
+
+	bool enabled() const { return _rate > 0; }
+		// Returns true if the bucket limits anything.
+	
+	bool available(UInt64 tokens, UInt64 now);
+		// Refills the bucket and returns true if the tokens are available.
+
+	void consume(UInt64 tokens);
+		// Removes tokens from the bucket, going into debt if required.
+	
+	UInt64 delay(UInt64 tokens) const;
+		// Returns the number of milliseconds until the tokens will be
+		// available, as of the last refill.
+
+protected:
+	void refill(UInt64 now);
+
+	UInt64 _rate;
+	UInt64 _burst;
+	Int64 _tokens;
+	UInt64 _remainder;
+	UInt64 _updated;
+};
+
+
+class RateShaper
+	/// Limits relayed traffic in both bytes and packets per second.
+{
+public:
+	RateShaper(const ShapingOptions& options, UInt64 now);
+	
+	bool available(std::size_t size, UInt64 now);
+		// Returns true if a packet of the given size fits within the rate.
+
+	bool admit(std::size_t size, UInt64 now);
+		// Consumes tokens and returns true if a packet of the given
+		// size fits within the rate, otherwise leaves the buckets alone.
+
+	void consume(std::size_t size);
+		// Consumes tokens for a packet unconditionally.
+
+	UInt64 delay(std::size_t size) const;
+		// Returns the number of milliseconds until a packet of the 
+		// given size will be admitted, as of the last available() call.
+
+	const ShapingOptions& options() const { return _options; }
+
+protected:
+	ShapingOptions _options;
+	TokenBucket _bytes;
+	TokenBucket _packets;
+};
+
+
+} } // namespace scy::turn
+
+
+#endif // SCY_TURN_RateShaper_H
@@ -0,0 +1,79 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#ifndef SCY_TURN_ResponseTemplate_H
+#define SCY_TURN_ResponseTemplate_H
+
+
+#include "scy/buffer.h"
+#include "scy/net/address.h"
+#include "scy/stun/message.h"
+
+#include <string>
+
+
+namespace scy {
+namespace turn {
+
+
+class ResponseTemplate
+	/// A pre-serialized STUN success response.
+	///
+	/// The message header and attribute headers are laid out once on
+	/// construction. Writing a response copies the template into the
+	/// output buffer and patches the transaction ID, the attribute value
+	/// and the MESSAGE-INTEGRITY HMAC in place, so no attributes are
+	/// allocated and no intermediate buffers are used.
+{
+public:
+	ResponseTemplate(stun::Message::MethodType method, 
+		UInt16 attrType = 0, UInt16 attrSize = 0);
+		// Creates a success response template for the given method with
+		// an optional single attribute of the given type and value size.
+	
+	std::size_t write(Buffer& buf, const stun::TransactionID& transactionID, 
+		const char* value = nullptr, const std::string& key = "") const;
+		// Appends a response to the given buffer and returns the number
+		// of bytes written. The value must point to the attribute value
+		// if the template has an attribute. The response is signed with
+		// MESSAGE-INTEGRITY if the key is not empty.
+
+	std::size_t size(bool sign) const;
+		// Returns the size of the serialized response.
+
+	static bool writeXorAddress(char* value, const net::Address& address);
+		// Encodes an IPv4 XOR address attribute value into 8 bytes.
+		// Returns false for addresses which cannot be encoded.
+	
+protected:
+	void build(Buffer& buf, bool sign);
+
+	stun::Message::MethodType _method;
+	UInt16 _attrType;
+	UInt16 _attrSize;
+	Buffer _plain;
+	Buffer _signed;
+};
+
+
+} } //  namespace scy::turn
+
+
+#endif // SCY_TURN_ResponseTemplate_H
@@ -0,0 +1,236 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef SCY_TURN_Server_H
+#define SCY_TURN_Server_H
+
+
+#include "scy/net/tcpsocket.h"
+#include "scy/net/udpsocket.h"
+#include "scy/timer.h"
+#include "scy/timerwheel.h"
+#include "scy/stun/message.h"
+#include "scy/turn/server/serverallocation.h"
+#include "scy/turn/server/udpallocation.h"
+#include "scy/turn/server/tcpallocation.h"
+#include "scy/turn/server/responsetemplate.h"
+#include "scy/turn/server/credentialcache.h"
+#include "scy/turn/server/rateshaper.h"
+#include "scy/turn/server/serverstats.h"
+#include "scy/turn/util.h"
+
+
+#include <assert.h>
+#include <string>
+#include <iostream>
+#include <algorithm>
+
+
+namespace scy {
+namespace turn {
+
+	
+struct ServerOptions 
+	/// Configuration options for the TURN server.
+{
+	std::string software;
+	std::string realm;
+
+	UInt32 allocationDefaultLifetime;
+	UInt32 allocationMaxLifetime;	
+	int allocationMaxPermissions;
+	int timerInterval;
+	int earlyMediaBufferSize;
+	int authCacheSize;       // Maximum number of cached credential keys, 0 to disable
+	Int64 authCacheTTL;      // Lifetime of cached credential keys in milliseconds
+	ShapingOptions allocationShaping; // Relay rate limits for each allocation
+	ShapingOptions userShaping;       // Relay rate limits shared by each user's allocations
+	
+	net::Address listenAddr; // The TCP and UDP bind() address
+	std::string externalIP;  // The external public facing IP address of the server
+
+	bool enableTCP;
+	bool enableUDP;
+	bool enableSplice;       // Relay bound TCP connections with splice(2) where supported
+
+	ServerOptions() {
+		software							= "Sourcey STUN/TURN Server [rfc5766]";
+		realm								= "sourcey.com";
+		listenAddr							= net::Address("0.0.0.0", 3478);
+		externalIP						    = "";
+		allocationDefaultLifetime			= 2 * 60 * 1000;
+		allocationMaxLifetime				= 15 * 60 * 1000;
+		allocationMaxPermissions			= 10;
+		timerInterval						= 10 * 1000;
+		earlyMediaBufferSize				= 8192;
+		authCacheSize						= 1024;
+		authCacheTTL						= 10 * 60 * 1000;
+		enableTCP							= true;
+		enableUDP							= true;
+		enableSplice						= false;
+	}
+};
+	
+
+struct ServerObserver 
+	/// The ServerObserver receives callbacks for and is responsible
+	/// for managing allocation and bandwidth quotas, authentication 
+	/// methods and authentication.
+{
+	virtual void onServerAllocationCreated(Server* server, IAllocation* alloc) = 0;
+	virtual void onServerAllocationRemoved(Server* server, IAllocation* alloc) = 0;
+
+	virtual AuthenticationState authenticateRequest(Server* server, Request& request) = 0;
+		// The observer class can implement authentication 
+		// using the long-term credential mechanism of [RFC5389].
+		// The class design is such that authentication can be preformed
+		// asynchronously against a remote database, or locally.
+		// The default implementation returns true to all requests.
+		//
+		// Set Request::hash to the derived key when authorizing a signed 
+		// request so the Server can cache it; later requests carrying the 
+		// same credentials and nonce are then verified without calling
+		// this method. See Server::authenticateRequest().
+		//
+		// To mitigate either intentional or unintentional denial-of-service
+		// attacks against the server by clients with valid usernames and
+		// passwords, it is RECOMMENDED that the server impose limits on both
+		// the number of allocations active at one time for a given username and
+		// on the amount of bandwidth those allocations can use.  The server
+		// should reject new allocations that would exceed the limit on the
+		// allowed number of allocations active at one time with a 486
+		// (Allocation Quota Exceeded) (see Section 6.2), and should discard
+		// application data traffic that exceeds the bandwidth quota.
+};
+
+
+typedef std::map<FiveTuple, ServerAllocation*> ServerAllocationMap;
+
+
+class Server
+	/// TURN server rfc5766 implementation
+{
+public:
+	Server(ServerObserver& observer, const ServerOptions& options = ServerOptions());
+	virtual ~Server();
+
+	virtual void start();
+	virtual void stop();
+	
+	AuthenticationState authenticateRequest(Request& request);
+		// Authenticates the request using the credential cache, falling
+		// back to the ServerObserver on a cache miss.
+		//
+		// Indications on the 5-tuple of an existing allocation skip
+		// authentication entirely, since the allocation was created by
+		// an authenticated Allocate request. Signed requests whose 
+		// username, realm and nonce match a cached entry are verified 
+		// against the cached key. Keys set in Request::hash by the 
+		// observer for authorized requests are cached.
+
+	void handleRequest(Request& request, AuthenticationState state);
+	void handleAuthorizedRequest(Request& request);
+	void handleBindingRequest(Request& request);
+	void handleAllocateRequest(Request& request);
+	void handleConnectionBindRequest(Request& request);
+
+	std::size_t handleChannelData(net::Socket* socket, const char* data, std::size_t len, const net::Address& peerAddress);
+		// Relays a ChannelData message from the client to the allocation
+		// on its 5-tuple. Returns the number of bytes consumed, or zero 
+		// if the message is malformed.
+	
+	void respond(Request& request, stun::Message& response);
+	void respondError(Request& request, int errorCode, const char* errorDesc);
+
+	void respondBinding(Request& request);
+	void respondRefresh(Request& request, UInt32 lifetime);
+	void respondCreatePermission(Request& request);
+	void respondChannelBind(Request& request);
+		// Send success responses from pre-serialized templates.
+
+	void flushResponses();
+		// Sends all UDP responses queued during the current loop iteration.
+		// This is called automatically from an idle handle.
+	
+	ServerAllocationMap allocations() const;
+	void addAllocation(ServerAllocation* alloc);
+	void removeAllocation(ServerAllocation* alloc);
+	ServerAllocation* getAllocation(const FiveTuple& tuple);
+	TCPAllocation* getTCPAllocation(const UInt32& connectionID);
+	std::shared_ptr<RateShaper> userShaper(const std::string& username);
+		// Returns the rate shaper shared by all allocations of the given 
+		// user, creating it if necessary.
+	net::TCPSocket::Ptr getTCPSocket(const net::Address& remoteAddr);
+	void releaseTCPSocket(net::Socket* socket);
+	
+	ServerObserver& observer();
+	ServerOptions& options();
+	net::UDPSocket& udpSocket();
+	net::TCPSocket& tcpSocket();
+	Timer& timer();
+	TimerWheel& wheel();
+		// Returns the timer wheel which schedules allocation, 
+		// permission and ConnectionBind expiries.
+	CredentialCache& credentials();
+	ServerStats& stats();
+		// Returns the server counters, which may be read from any thread.
+	
+	void onTCPAcceptConnection(void* sender, const net::TCPSocket::Ptr& sock);
+	void onTCPSocketClosed(void* sender);
+	void onSocketRecv(void* sender, const MutableBuffer& buffer, const net::Address& peerAddress);
+	void onTimer(void*);
+	
+protected:
+	void sendResponse(Request& request, const ResponseTemplate& response, const char* value = nullptr);
+	void sendResponse(Request& request, const char* data, std::size_t len);
+	void queueResponse(std::size_t offset, std::size_t size, const net::Address& peerAddress);
+	
+	struct PendingResponse
+	{
+		std::size_t offset;
+		std::size_t size;
+		net::Address peerAddress;
+	};
+
+private:	
+	ServerObserver& _observer;
+	ServerOptions _options;
+	net::UDPSocket _udpSocket;
+	net::TCPSocket _tcpSocket;	
+	net::TCPSocket::Vec _tcpSockets;
+	ServerAllocationMap	_allocations;
+	Timer _timer;
+	TimerWheel _wheel;
+	CredentialCache _credentials;
+	ServerStats _stats;
+	std::map<std::string, std::weak_ptr<RateShaper>> _userShapers;
+	ResponseTemplate _bindingResponse;
+	ResponseTemplate _refreshResponse;
+	ResponseTemplate _permissionResponse;
+	ResponseTemplate _channelBindResponse;
+	std::vector<PendingResponse> _pendingResponses;
+	Buffer _responseBuffer;
+	uv::Handle _responseFlusher;
+};
+
+
+} } //  namespace scy::turn
+
+
+#endif // SCY_TURN_Server_H
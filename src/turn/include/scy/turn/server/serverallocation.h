@@ -0,0 +1,131 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef SCY_TURN_ServerAllocation_H
+#define SCY_TURN_ServerAllocation_H
+
+
+#include "scy/turn/iallocation.h"
+#include "scy/turn/fivetuple.h"
+#include "scy/turn/server/rateshaper.h"
+#include "scy/timerwheel.h"
+
+#include <memory>
+
+
+namespace scy {
+namespace turn {
+
+
+class Server;
+
+
+class ServerAllocation: public IAllocation
+{
+public:
+	ServerAllocation(Server& server, 
+					 const FiveTuple& tuple, 
+					 const std::string& username, 
+					 Int64 lifetime);
+	
+	virtual bool handleRequest(Request& request);	
+	virtual void handleRefreshRequest(Request& request);	
+	virtual void handleCreatePermission(Request& request);
+	virtual void handleChannelData(UInt16 channel, const char* data, std::size_t size);
+		// Relays ChannelData from the client to the peer bound to 
+		// the channel. Allocations without channels discard it.
+		
+	//virtual bool IAllocation::deleted() const;
+
+	virtual void setLifetime(Int64 lifetime);
+		// Sets the lifetime and reschedules the allocation expiry.
+
+	virtual void addPermission(const std::string& ip);
+		// Adds or refreshes a permission and schedules its expiry.
+
+	void expire();
+		// Flags the allocation as deleted and schedules its 
+		// destruction on the next tick of the server timer wheel.
+		// Used when the allocation quota has been reached.
+	
+	virtual Int64 timeRemaining() const; 
+	virtual Int64 maxTimeRemaining() const;
+	virtual Server& server(); 
+
+	bool available(std::size_t size);
+		// Returns true if relayed data of the given size is within the
+		// allocation and user rate limits, without consuming tokens.
+		// Always true when shaping is disabled.
+
+	bool admit(std::size_t size);
+		// Returns true if relayed data of the given size is within the
+		// allocation and user rate limits, and consumes tokens if so.
+		// Always true when shaping is disabled.
+
+	void consume(std::size_t size);
+		// Consumes tokens for relayed data regardless of the rate limits.
+
+	UInt64 admitDelay(std::size_t size) const;
+		// Returns the milliseconds until data of the given size will be
+		// admitted, as of the last available() or admit() call.
+
+	const ShapingOptions& shapingOptions() const;
+		// Returns the shaping options in effect for this allocation,
+		// preferring the allocation options over the user options.
+	
+	virtual void print(std::ostream& os) const;
+
+protected:
+	virtual ~ServerAllocation();
+		// IMPORTANT: The destructor should never be called directly 
+		// as the allocation is deleted via the expiry callback.
+		// See onExpiry()
+
+	virtual void onExpiry();
+		// Deletes the allocation if it has expired, otherwise 
+		// reschedules the expiry for the remaining lifetime.
+		// The lifetime is extended by usage, so it is only
+		// checked when the previous deadline is reached.
+
+	virtual void onPermissionExpiry();
+		// Removes expired permissions and reschedules the expiry
+		// for the next permission due.
+
+	friend class Server;
+	
+	UInt32 _maxLifetime;
+	Server&	_server;
+	std::unique_ptr<RateShaper> _shaper;
+	std::shared_ptr<RateShaper> _userShaper;
+	TimerWheel::Entry _expiry;
+	TimerWheel::Entry _permissionExpiry;
+
+private:	
+	ServerAllocation(const ServerAllocation&); // = delete;
+	ServerAllocation(ServerAllocation&&); // = delete;
+	ServerAllocation& operator=(const ServerAllocation&); // = delete;
+	ServerAllocation& operator=(ServerAllocation&&); // = delete;
+
+};
+
+
+} } // namespace scy::turn
+
+
+#endif // SCY_TURN_ServerAllocation_H
@@ -0,0 +1,181 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#ifndef SCY_TURN_ServerStats_H
+#define SCY_TURN_ServerStats_H
+
+
+#include "scy/types.h"
+#include "scy/stun/message.h"
+
+#include <atomic>
+#include <ostream>
+
+
+namespace scy {
+namespace turn {
+
+
+class LatencyHistogram
+	/// A lock-free histogram of durations in microseconds.
+	/// Bucket upper bounds are powers of two from 1us, with 
+	/// the last bucket counting everything larger.
+{
+public:
+	enum { NumBuckets = 18 };
+
+	struct Snapshot
+	{
+		UInt64 buckets[NumBuckets];
+		UInt64 count;
+		UInt64 sum;
+	};
+
+	LatencyHistogram();
+
+	void record(UInt64 usec);
+		// Adds a duration to the histogram.
+
+	Snapshot snapshot() const;
+		// Returns a copy of the current counts.
+
+	static UInt64 bucketBound(int index);
+		// Returns the inclusive upper bound of a bucket in microseconds.
+
+protected:
+	std::atomic<UInt64> _buckets[NumBuckets];
+	std::atomic<UInt64> _count;
+	std::atomic<UInt64> _sum;
+};
+
+
+class ServerStats
+	/// Counters for monitoring the TURN server under load.
+	///
+	/// Counters are updated with relaxed atomic increments so they
+	/// may be read from any thread without slowing the relay path.
+	/// Use snapshot() to read a consistent enough copy, and 
+	/// writeJSON() or writePrometheus() to export it.
+{
+public:
+	enum Direction
+	{
+		ToPeer,
+		ToClient,
+		NumDirections
+	};
+
+	enum DropReason
+	{
+		QuotaReached,    // The allocation quota or lifetime was exceeded
+		RateLimited,     // Dropped by the rate shaper
+		QueueFull,       // The rate shaper queue was full
+		NoAllocation,    // No allocation matched the 5-tuple
+		InvalidMessage,  // The packet could not be parsed
+		NumDropReasons
+	};
+
+	enum { NumMethods = 16 };
+
+	struct Snapshot
+	{
+		UInt64 requests[NumMethods];
+		UInt64 authFailures;
+		UInt64 allocationsActive;
+		UInt64 allocationsCreated;
+		UInt64 allocationsExpired;
+		UInt64 relayedBytes[NumDirections];
+		UInt64 relayedPackets[NumDirections];
+		UInt64 permissionMisses;
+		UInt64 drops[NumDropReasons];
+		LatencyHistogram::Snapshot latency;
+	};
+
+	ServerStats();
+
+	void request(stun::Message::MethodType method)
+	{ 
+		inc(_requests[method & (NumMethods - 1)]); 
+	}
+
+	void authFailure() { inc(_authFailures); }
+	void permissionMiss() { inc(_permissionMisses); }
+	void drop(DropReason reason) { inc(_drops[reason]); }
+	void requestLatency(UInt64 usec) { _latency.record(usec); }
+
+	void allocationCreated() 
+	{ 
+		inc(_allocationsCreated); 
+		inc(_allocationsActive); 
+	}
+
+	void allocationRemoved() 
+	{ 
+		_allocationsActive.fetch_sub(1, std::memory_order_relaxed); 
+	}
+
+	void allocationExpired() { inc(_allocationsExpired); }
+
+	void relayed(Direction dir, std::size_t size) 
+	{ 
+		_relayedBytes[dir].fetch_add(size, std::memory_order_relaxed); 
+		inc(_relayedPackets[dir]); 
+	}
+
+	Snapshot snapshot() const;
+		// Returns a copy of all counters.
+
+	void writeJSON(std::ostream& os) const;
+		// Writes a snapshot as a JSON object.
+
+	void writePrometheus(std::ostream& os) const;
+		// Writes a snapshot in the Prometheus text exposition format.
+
+	static const char* methodName(int method);
+	static const char* directionName(int dir);
+	static const char* dropReasonName(int reason);
+
+protected:
+	static void inc(std::atomic<UInt64>& counter) 
+	{ 
+		counter.fetch_add(1, std::memory_order_relaxed); 
+	}
+
+	std::atomic<UInt64> _requests[NumMethods];
+	std::atomic<UInt64> _authFailures;
+	std::atomic<UInt64> _allocationsActive;
+	std::atomic<UInt64> _allocationsCreated;
+	std::atomic<UInt64> _allocationsExpired;
+	std::atomic<UInt64> _relayedBytes[NumDirections];
+	std::atomic<UInt64> _relayedPackets[NumDirections];
+	std::atomic<UInt64> _permissionMisses;
+	std::atomic<UInt64> _drops[NumDropReasons];
+	LatencyHistogram _latency;
+
+private:
+	ServerStats(const ServerStats&); // = delete;
+	ServerStats& operator=(const ServerStats&); // = delete;
+};
+
+
+} } // namespace scy::turn
+
+
+#endif // SCY_TURN_ServerStats_H
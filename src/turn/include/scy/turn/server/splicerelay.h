@@ -0,0 +1,105 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#ifndef SCY_TURN_SpliceRelay_H
+#define SCY_TURN_SpliceRelay_H
+
+
+#include "scy/uv/uvpp.h"
+#include "scy/types.h"
+
+#include <functional>
+
+
+namespace scy {
+namespace turn {
+
+
+class SpliceRelay
+	/// Relays data between two connected TCP sockets inside the kernel
+	/// using splice(2) through a pipe, so payloads never enter user 
+	/// space. This is only available on Linux; start() returns false
+	/// elsewhere, or when the relay cannot be set up, and the caller 
+	/// should continue relaying in user space.
+	///
+	/// The relay polls duplicates of the socket descriptors, so the
+	/// sockets' own libuv handles must not be reading or writing while
+	/// the relay is running.
+{
+public:
+	enum Direction
+	{
+		ToPeer,
+		ToClient
+	};
+
+	SpliceRelay(int clientFd, int peerFd, uv::Loop* loop = uv::defaultLoop());
+	~SpliceRelay();
+
+	bool start();
+		// Starts relaying. Returns false if splicing is unsupported.
+
+	void stop();
+		// Stops relaying and releases the pipes and descriptors.
+
+	bool active() const;
+
+	static bool supported();
+		// Returns true if the platform supports splice(2).
+
+	std::function<bool(Direction, std::size_t)> Relayed;
+		// Called with the number of bytes moved to the destination
+		// socket. Return false to stop the relay, which is then 
+		// treated as closed.
+
+	std::function<void()> Closed;
+		// Called when both directions have reached EOF, or when
+		// either socket fails. EOF in one direction only shuts 
+		// down the write side of the other socket.
+		// The relay may be deleted from within the callback.
+
+protected:
+	struct Channel
+	{
+		int source;      // The index of the source endpoint
+		int pipe[2];
+		std::size_t pending; // Bytes in the pipe
+		bool eof;            // The source has shut down
+		bool done;           // EOF was passed on to the destination
+	};
+
+	bool transfer(Channel& channel);
+	bool flush(Channel& channel);
+	void updatePoll(int index);
+	void onPoll(uv_poll_t* handle, int status, int events);
+	
+	uv::Loop* _loop;
+	int _fds[2];           // The socket descriptors, client then peer
+	int _dups[2];          // Duplicates of the socket descriptors
+	uv::Handle* _polls[2]; // Poll handles for the duplicates
+	Channel _channels[2];  // Indexed by Direction
+	bool _active;
+};
+
+
+} } // namespace scy::turn
+
+
+#endif // SCY_TURN_SpliceRelay_H
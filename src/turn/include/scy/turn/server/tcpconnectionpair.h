@@ -0,0 +1,141 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef SCY_TURN_TCPClientConnection_H
+#define SCY_TURN_TCPClientConnection_H
+
+
+#include "scy/collection.h"
+#include "scy/timer.h"
+#include "scy/timerwheel.h"
+#include "scy/turn/server/splicerelay.h"
+#include "scy/stun/message.h"
+#include "scy/net/tcpsocket.h"
+
+
+namespace scy {
+namespace turn {
+
+	
+class TCPAllocation;
+
+class TCPConnectionPair
+{
+public:	
+	TCPConnectionPair(TCPAllocation& allocation);
+	virtual ~TCPConnectionPair();
+
+	bool doPeerConnect(const net::Address& peerAddr);
+		// Initiates an outgoing TCP connection to the
+		// peer for Connect requests.
+
+	bool makeDataConnection();
+		// Binds the client <> peer relay pipe once the 
+		// ConnectionBind request is successfull.
+
+	bool startSplice();
+		// Moves the relay into the kernel using a SpliceRelay.
+		// Only unshaped relays with no pending writes are spliced.
+		// Returns false if the relay remains in user space.
+	
+	void setPeerSocket(const net::TCPSocket::Ptr& socket);
+	void setClientSocket(const net::TCPSocket::Ptr& socket);
+
+	void onPeerConnectSuccess(void* sender); 
+		// Connection success callback for Connect request.
+
+	void onPeerConnectError(void* sender, const Error& error);
+		// Connection error callback for Connect request.
+	
+	void onClientDataReceived(void* sender, const MutableBuffer& buffer, const net::Address& peerAddress);
+	void onPeerDataReceived(void* sender, const MutableBuffer& buffer, const net::Address& peerAddress);
+
+	void throttle(net::TCPSocket& source, std::size_t size);
+		// Charges relayed data against the allocation rate limits.
+		// If the limits are exceeded reading from the source socket is
+		// paused until enough tokens have accrued.
+
+	void onThrottleTimer(void*);
+		// Resumes reading from each socket paused by throttle() once
+		// the rate limits admit the read which paused it.
+
+	void startThrottleTimer();
+		// Schedules onThrottleTimer() for when the first paused 
+		// socket is expected to recover.
+
+	void onConnectionClosed(void* sender);
+		// Callback for handing either client or peer connections
+		// which result in the destruction of the TCPConnectionPair.
+
+	void startTimeout();
+		// Starts the ConnectionBind request timeout.
+		//
+		// If no ConnectionBind request associated with this peer data
+		// connection is received after 30 seconds, the peer data
+		// connection MUST be closed.
+
+	void onTimeout();
+		// Deletes the connection pair if the ConnectionBind request
+		// has not been received.
+
+	TCPAllocation& allocation;
+
+	net::TCPSocket::Ptr client;
+		// The client socket, nullptr to start.
+
+	net::TCPSocket::Ptr peer;
+		// The client socket, nullptr to start.
+
+	Buffer earlyPeerData;	
+		// Stores early peer > client data.
+		
+	UInt32 connectionID;
+	    // The unique connection ID.
+
+	bool isDataConnection;
+		// True when p2p relay is flowing.
+	
+	TimerWheel::Entry timeout;
+		// The ConnectionBind request timeout.
+
+	Timer throttleTimer;
+		// Resumes reading when the relay is throttled.
+
+	std::size_t clientThrottled;
+	std::size_t peerThrottled;
+		// The size of the read which paused each socket,
+		// or zero if the socket is not throttled.
+
+	std::unique_ptr<SpliceRelay> relay;
+		// The kernel relay, if splicing.
+
+	stun::TransactionID	transactionID;
+
+private:	
+	TCPConnectionPair(const TCPConnectionPair&); // = delete;
+	TCPConnectionPair(TCPConnectionPair&&); // = delete;
+	TCPConnectionPair& operator=(const TCPConnectionPair&); // = delete;
+	TCPConnectionPair& operator=(TCPConnectionPair&&); // = delete;
+};
+
+
+} } // namespace scy::turn
+
+
+#endif // SCY_TURN_TCPClientConnection_H
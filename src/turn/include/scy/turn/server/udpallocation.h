@@ -0,0 +1,113 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef SCY_TURN_SERVER_UDPAllocation_H
+#define SCY_TURN_SERVER_UDPAllocation_H
+
+
+#include "scy/turn/server/serverallocation.h"
+#include "scy/net/packetsocket.h"
+#include "scy/net/udpsocket.h"
+#include "scy/timer.h"
+
+#include <deque>
+#include <vector>
+
+
+namespace scy {
+namespace turn {
+
+
+class Server;
+class IConnection;
+
+
+class UDPAllocation: public ServerAllocation
+{
+public:
+	UDPAllocation(
+		Server& server,
+		const FiveTuple& tuple, 
+		const std::string& username, 
+		const UInt32& lifetime);
+	virtual ~UDPAllocation();
+
+	//void onPacketReceived(void* sender, RawPacket& packet);
+	void onPeerDataReceived(void*, const MutableBuffer& buffer, const net::Address& peerAddress);
+		
+	bool handleRequest(Request& request);	
+	void handleSendIndication(Request& request);
+	void handleChannelBindRequest(Request& request);
+	void handleChannelData(UInt16 channel, const char* data, std::size_t size);
+
+	int send(const char* data, std::size_t size, const net::Address& peerAddress);
+		// Relays data to the peer, subject to the allocation quota and
+		// rate limits. Returns -1 if the quota has been reached.
+
+	void sendDataIndication(const char* data, std::size_t size, const net::Address& peerAddress);
+		// Relays peer data to the client inside a Data indication.
+
+	void sendChannelData(UInt16 channel, const char* data, std::size_t size);
+		// Relays peer data to the client inside a ChannelData message.
+	
+	net::Address relayedAddress() const;
+
+protected:
+	bool shape(const char* data, std::size_t size, const net::Address& address, bool toPeer);
+		// Returns true if the datagram may be relayed now, otherwise
+		// queues or drops it according to the shaping policy.
+
+	void sendToClient(const char* data, std::size_t size, const net::Address& peerAddress);
+		// Relays peer data to the client through the channel bound 
+		// to the peer, or inside a Data indication if there is none.
+
+	void scheduleQueue();
+	void onQueueTimer(void*);
+
+	struct ChannelBinding
+	{
+		UInt16 number;
+		net::Address peerAddress;
+		UInt64 expiresAt; // The loop time when the binding expires
+	};
+
+	ChannelBinding* getChannel(UInt16 number);
+	ChannelBinding* getChannel(const net::Address& peerAddress);
+		// Return the unexpired binding for the channel or peer, if any.
+
+	struct QueuedDatagram
+	{
+		Buffer data;
+		net::Address address;
+		bool toPeer;
+	};
+
+private:
+	net::UDPSocket _relaySocket;
+	std::vector<ChannelBinding> _channels;
+	std::deque<QueuedDatagram> _queue;
+	std::size_t _queueSize;
+	Timer _queueTimer;
+};
+
+
+} } //  namespace scy::turn
+
+
+#endif // SCY_TURN_SERVER_UDPAllocation_H
\ No newline at end of file
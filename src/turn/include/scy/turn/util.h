@@ -0,0 +1,68 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef SCY_TURN_Utilities_H
+#define SCY_TURN_Utilities_H
+
+
+#include "scy/turn/types.h"
+#include "scy/byteorder.h"
+
+#include <cstring>
+
+
+namespace scy {
+namespace turn {
+
+
+inline bool isChannelData(const char* data, std::size_t size)
+	// Returns true if the buffer starts with a ChannelData message.
+	// The first two bits of a ChannelData message are 0b01, which
+	// distinguishes it from a STUN message.
+{
+	return size >= CHANNEL_DATA_HEADER_SIZE && 
+		(static_cast<UInt8>(data[0]) & 0xC0) == 0x40;
+}
+
+
+inline void writeChannelDataHeader(char* header, UInt16 channel, std::size_t size)
+	// Writes a ChannelData header for a payload of the given size.
+{
+	UInt16 value = hostToNetwork16(channel);
+	std::memcpy(header, &value, 2);
+	value = hostToNetwork16(static_cast<UInt16>(size));
+	std::memcpy(header + 2, &value, 2);
+}
+
+
+inline void readChannelDataHeader(const char* header, UInt16& channel, UInt16& size)
+	// Reads a ChannelData header.
+{
+	UInt16 value;
+	std::memcpy(&value, header, 2);
+	channel = networkToHost16(value);
+	std::memcpy(&value, header + 2, 2);
+	size = networkToHost16(value);
+}
+
+
+} } // namespace scy::turn
+
+
+#endif
\ No newline at end of file
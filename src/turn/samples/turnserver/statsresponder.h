@@ -0,0 +1,66 @@
+#ifndef SCY_TURN_StatsResponder_H
+#define SCY_TURN_StatsResponder_H
+
+
+#include "scy/http/server.h"
+#include "scy/turn/server/server.h"
+
+#include <sstream>
+
+
+namespace scy {
+namespace turn {
+
+
+class StatsResponder: public http::ServerResponder
+	/// Serves the TURN server counters as JSON, or in the 
+	/// Prometheus text format for requests to /metrics.
+{
+public:
+	StatsResponder(http::ServerConnection& connection, Server& server) :
+		http::ServerResponder(connection), _server(server)
+	{
+	}
+	
+	void onRequest(http::Request& request, http::Response& response) 
+	{
+		std::ostringstream os;
+		if (request.getURI() == "/metrics") {
+			_server.stats().writePrometheus(os);
+			response.setContentType("text/plain; version=0.0.4");
+		}
+		else {
+			_server.stats().writeJSON(os);
+			response.setContentType("application/json");
+		}
+
+		std::string body(os.str());
+		response.setContentLength(body.length()); // headers will be auto flushed
+		connection().send(body.c_str(), body.length());
+		connection().close();
+	}
+
+protected:
+	Server& _server;
+};
+
+
+class StatsResponderFactory: public http::ServerResponderFactory
+{
+public:
+	StatsResponderFactory(Server& server) : _server(server) {}
+
+	http::ServerResponder* createResponder(http::ServerConnection& connection)
+	{
+		return new StatsResponder(connection, _server);
+	}
+
+protected:
+	Server& _server;
+};
+
+
+} } // namespace scy::turn
+
+
+#endif // SCY_TURN_StatsResponder_H
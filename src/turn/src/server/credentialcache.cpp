@@ -0,0 +1,141 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#include "scy/turn/server/credentialcache.h"
+
+
+namespace scy {
+namespace turn {
+
+
+CredentialCache::CredentialCache(uv::Loop* loop, std::size_t limit, Int64 ttl) :
+	_loop(loop),
+	_limit(limit),
+	_ttl(ttl)
+{
+}
+
+
+CredentialCache::~CredentialCache()
+{
+}
+
+
+bool CredentialCache::find(const std::string& username, const std::string& realm, 
+	const std::string& nonce, std::string& key)
+{
+	auto it = _entries.find(username + ":" + realm);
+	if (it != _entries.end()) {
+		Entry& entry = it->second;
+
+		// Expired entries are dropped on access
+		if (entry.expires <= (Int64)uv_now(_loop)) {
+			_lru.erase(entry.lru);
+			_entries.erase(it);
+		}
+		else if (entry.nonce == nonce) {
+			_lru.splice(_lru.begin(), _lru, entry.lru);
+			key = entry.key;
+			_stats.hits++;
+			return true;
+		}
+	}
+	
+	_stats.misses++;
+	return false;
+}
+
+
+void CredentialCache::store(const std::string& username, const std::string& realm, 
+	const std::string& nonce, const std::string& key)
+{
+	if (!_limit)
+		return;
+
+	std::string id(username + ":" + realm);
+	auto it = _entries.find(id);
+	if (it == _entries.end()) {
+		_lru.push_front(id);
+		it = _entries.insert(std::make_pair(id, Entry())).first;
+		it->second.lru = _lru.begin();
+	}
+	else _lru.splice(_lru.begin(), _lru, it->second.lru);
+
+	Entry& entry = it->second;
+	entry.key = key;
+	entry.nonce = nonce;
+	entry.expires = (Int64)uv_now(_loop) + _ttl;
+	prune();
+}
+
+
+void CredentialCache::invalidate(const std::string& username, const std::string& realm)
+{
+	auto it = _entries.find(username + ":" + realm);
+	if (it != _entries.end()) {
+		_lru.erase(it->second.lru);
+		_entries.erase(it);
+	}
+}
+
+
+void CredentialCache::clear()
+{
+	_entries.clear();
+	_lru.clear();
+}
+
+
+void CredentialCache::setLimit(std::size_t limit)
+{
+	_limit = limit;
+	prune();
+}
+
+
+void CredentialCache::setTTL(Int64 ttl)
+{
+	_ttl = ttl;
+}
+
+
+std::size_t CredentialCache::size() const
+{
+	return _entries.size();
+}
+
+
+const CredentialCache::Stats& CredentialCache::stats() const
+{
+	return _stats;
+}
+
+
+void CredentialCache::prune()
+{
+	while (_entries.size() > _limit) {
+		_entries.erase(_lru.back());
+		_lru.pop_back();
+		_stats.evicted++;
+	}
+}
+
+
+} } //  namespace scy::turn
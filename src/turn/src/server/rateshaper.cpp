@@ -0,0 +1,124 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#include "scy/turn/server/rateshaper.h"
+
+#include <algorithm>
+
+
+namespace scy {
+namespace turn {
+
+
+TokenBucket::TokenBucket(UInt64 rate, UInt64 burst, UInt64 now) :
+	_rate(rate),
+	_burst(burst ? burst : rate),
+	_tokens(static_cast<Int64>(_burst)),
+	_remainder(0),
+	_updated(now)
+{
+}
+
+
+void TokenBucket::refill(UInt64 now)
+{
+	if (now <= _updated)
+		return;
+
+	// Tokens accrue per millisecond; keep the fraction for next time
+	UInt64 scaled = (now - _updated) * _rate + _remainder;
+	_updated = now;
+	_tokens += static_cast<Int64>(scaled / 1000);
+	_remainder = scaled % 1000;
+	if (_tokens >= static_cast<Int64>(_burst)) {
+		_tokens = static_cast<Int64>(_burst);
+		_remainder = 0;
+	}
+}
+
+
+bool TokenBucket::available(UInt64 tokens, UInt64 now)
+{
+	if (!_rate)
+		return true;
+
+	// Packets larger than the bucket are admitted once it is full
+	refill(now);
+	return _tokens >= std::min<Int64>(tokens, _burst);
+}
+
+
+void TokenBucket::consume(UInt64 tokens)
+{
+	if (_rate)
+		_tokens -= static_cast<Int64>(tokens);
+}
+
+
+UInt64 TokenBucket::delay(UInt64 tokens) const
+{
+	Int64 target = std::min<Int64>(tokens, _burst);
+	if (!_rate || _tokens >= target)
+		return 0;
+
+	UInt64 needed = static_cast<UInt64>(target - _tokens);
+	return (needed * 1000 - _remainder + _rate - 1) / _rate;
+}
+
+
+RateShaper::RateShaper(const ShapingOptions& options, UInt64 now) :
+	_options(options),
+	_bytes(options.bytesPerSecond, options.burstBytes, now),
+	_packets(options.packetsPerSecond, options.burstPackets, now)
+{
+}
+
+
+bool RateShaper::available(std::size_t size, UInt64 now)
+{
+	return _bytes.available(size, now) 
+		&& _packets.available(1, now);
+}
+
+
+bool RateShaper::admit(std::size_t size, UInt64 now)
+{
+	if (!available(size, now))
+		return false;
+
+	consume(size);
+	return true;
+}
+
+
+void RateShaper::consume(std::size_t size)
+{
+	_bytes.consume(size);
+	_packets.consume(1);
+}
+
+
+UInt64 RateShaper::delay(std::size_t size) const
+{
+	return std::max<UInt64>(_bytes.delay(size), _packets.delay(1));
+}
+
+
+} } // namespace scy::turn
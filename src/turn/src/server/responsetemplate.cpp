@@ -0,0 +1,123 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#include "scy/turn/server/responsetemplate.h"
+#include "scy/stun/attributes.h"
+#include "scy/crypto/hmac.h"
+
+#include <cstring>
+
+
+namespace scy {
+namespace turn {
+
+
+ResponseTemplate::ResponseTemplate(stun::Message::MethodType method, UInt16 attrType, UInt16 attrSize) :
+	_method(method),
+	_attrType(attrType),
+	_attrSize(attrSize)
+{
+	build(_plain, false);
+	build(_signed, true);
+}
+
+
+void ResponseTemplate::build(Buffer& buf, bool sign)
+{
+	// Attribute values are padded to a multiple of 4 bytes
+	std::size_t padded = (_attrSize + 3) & ~3;
+	std::size_t length = 0;
+	if (_attrType)
+		length += stun::kAttributeHeaderSize + padded;
+	if (sign)
+		length += stun::kAttributeHeaderSize + stun::MessageIntegrity::Size;
+
+	// The length field already includes MESSAGE-INTEGRITY since 
+	// it is the last attribute, so the HMAC input needs no patching.
+	BitWriter writer(buf);
+	writer.reserve(stun::kMessageHeaderSize + length);
+	writer.putU16(UInt16(stun::Message::SuccessResponse | _method));
+	writer.putU16(UInt16(length));
+	writer.putU32(stun::kMagicCookie);
+	writer.put(std::string(stun::kTransactionIdLength, '\0'));
+	if (_attrType) {
+		writer.putU16(_attrType);
+		writer.putU16(_attrSize);
+		writer.put(std::string(padded, '\0'));
+	}
+	if (sign) {
+		writer.putU16(stun::MessageIntegrity::TypeID);
+		writer.putU16(stun::MessageIntegrity::Size);
+		writer.put(std::string(stun::MessageIntegrity::Size, '\0'));
+	}
+}
+
+
+std::size_t ResponseTemplate::write(Buffer& buf, const stun::TransactionID& transactionID, 
+	const char* value, const std::string& key) const
+{
+	assert(transactionID.size() == stun::kTransactionIdLength);
+	assert(!_attrType || value);
+
+	const Buffer& tmpl = key.empty() ? _plain : _signed;
+	std::size_t offset = buf.size();
+	buf.insert(buf.end(), tmpl.begin(), tmpl.end());
+	
+	char* msg = &buf[offset];
+	std::memcpy(msg + stun::kTransactionIdOffset, transactionID.data(), stun::kTransactionIdLength);
+	if (_attrType)
+		std::memcpy(msg + stun::kMessageHeaderSize + stun::kAttributeHeaderSize, value, _attrSize);
+
+	if (!key.empty()) {
+		std::size_t integrityOffset = tmpl.size() - stun::MessageIntegrity::Size;
+		std::string hmac(crypto::computeHMAC(
+			std::string(msg, integrityOffset - stun::kAttributeHeaderSize), key));
+		assert(hmac.size() == stun::MessageIntegrity::Size);
+		std::memcpy(msg + integrityOffset, hmac.data(), stun::MessageIntegrity::Size);
+	}
+	return tmpl.size();
+}
+
+
+std::size_t ResponseTemplate::size(bool sign) const
+{
+	return sign ? _signed.size() : _plain.size();
+}
+
+
+bool ResponseTemplate::writeXorAddress(char* value, const net::Address& address)
+{
+	if (address.family() != net::Address::IPv4)
+		return false;
+	
+	auto v4addr = reinterpret_cast<const sockaddr_in*>(address.addr());
+	UInt16 port = ntohs(v4addr->sin_port) ^ (stun::kMagicCookie >> 16);
+	UInt32 ip = ntohl(v4addr->sin_addr.s_addr) ^ stun::kMagicCookie;
+
+	BitWriter writer(value, stun::AddressAttribute::IPv4Size);
+	writer.putU8(0);
+	writer.putU8(stun::IPv4);
+	writer.putU16(port);
+	writer.putU32(ip);
+	return true;
+}
+
+
+} } //  namespace scy::turn
@@ -0,0 +1,346 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "scy/turn/server/server.h"
+#include "scy/logger.h"
+#include "scy/util.h"
+
+#include <algorithm>
+
+
+using namespace std;
+
+
+namespace scy {
+namespace turn {
+
+
+ServerAllocation::ServerAllocation(Server& server, const FiveTuple& tuple, const std::string& username, Int64 lifetime) : 
+	IAllocation(tuple, username, lifetime),
+	_maxLifetime(server.options().allocationMaxLifetime / 1000),
+	_server(server)
+{
+	UInt64 now = uv_now(uv::defaultLoop());
+	const ServerOptions& options = server.options();
+	if (options.allocationShaping.enabled())
+		_shaper.reset(new RateShaper(options.allocationShaping, now));
+	if (options.userShaping.enabled())
+		_userShaper = server.userShaper(username);
+
+	_expiry.callback = [this]() { onExpiry(); };
+	_permissionExpiry.callback = [this]() { onPermissionExpiry(); };
+	_server.wheel().schedule(_expiry, timeRemaining() * 1000);
+
+	_server.addAllocation(this);
+}
+
+
+ServerAllocation::~ServerAllocation() 
+{
+	_server.removeAllocation(this);	
+}
+
+
+bool ServerAllocation::available(std::size_t size)
+{
+	if (!_shaper && !_userShaper)
+		return true;
+
+	UInt64 now = uv_now(uv::defaultLoop());
+	return (!_shaper || _shaper->available(size, now)) &&
+		(!_userShaper || _userShaper->available(size, now));
+}
+
+
+bool ServerAllocation::admit(std::size_t size)
+{
+	// Both limits must allow the data before either is charged
+	if (!available(size))
+		return false;
+
+	consume(size);
+	return true;
+}
+
+
+void ServerAllocation::consume(std::size_t size)
+{
+	if (_shaper)
+		_shaper->consume(size);
+	if (_userShaper)
+		_userShaper->consume(size);
+}
+
+
+UInt64 ServerAllocation::admitDelay(std::size_t size) const
+{
+	UInt64 delay = 0;
+	if (_shaper)
+		delay = _shaper->delay(size);
+	if (_userShaper)
+		delay = std::max<UInt64>(delay, _userShaper->delay(size));
+	return delay;
+}
+
+
+const ShapingOptions& ServerAllocation::shapingOptions() const
+{
+	if (_shaper)
+		return _shaper->options();
+	if (_userShaper)
+		return _userShaper->options();
+	return _server.options().allocationShaping;
+}
+
+
+bool ServerAllocation::handleRequest(Request& request) 
+{	
+	TraceL << "Handle Request" << endl;	
+	
+	if (IAllocation::deleted()) {
+		WarnL << "Dropping request for deleted allocation" << endl;			
+		return false;
+	}
+
+	if (request.methodType() == stun::Message::CreatePermission)
+		handleCreatePermission(request);
+	else if (request.methodType() == stun::Message::Refresh)	
+		handleRefreshRequest(request);
+	else
+		return false; //respondError(request, 600, "Operation Not Supported");
+	
+	return true; 
+}
+
+
+void ServerAllocation::handleRefreshRequest(Request& request) 
+{
+	TraceL << "Handle Refresh Request" << endl;
+	assert(request.methodType() == stun::Message::Refresh);
+	assert(request.classType() == stun::Message::Request);
+
+	// 7.2. Receiving a Refresh Request
+
+	// When the server receives a Refresh request, it processes as per
+	// Section 4 plus the specific rules mentioned here.
+
+	// The server computes a value called the "desired lifetime" as follows:
+	// if the request contains a LIFETIME attribute and the attribute value
+	// is 0, then the "desired lifetime" is 0.  Otherwise, if the request
+	// contains a LIFETIME attribute, then the server computes the minimum
+	// of the client's requested lifetime and the server's maximum allowed
+	// lifetime.  If this computed value is greater than the default
+	// lifetime, then the "desired lifetime" is the computed value.
+	// Otherwise, the "desired lifetime" is the default lifetime.	
+
+	// Compute the appropriate LIFETIME for this allocation.
+	auto lifetimeAttr = request.get<stun::Lifetime>();
+	if (!lifetimeAttr) {
+		return;
+	}	
+	UInt32 desiredLifetime = std::min<UInt32>(_server.options().allocationMaxLifetime / 1000, lifetimeAttr->value());
+	//lifetime = min(lifetime, lifetimeAttr->value() * 1000);
+
+	// Subsequent processing depends on the "desired lifetime" value:
+
+	// o  If the "desired lifetime" is 0, then the request succeeds and the
+	//    allocation is deleted.
+
+	// o  If the "desired lifetime" is non-zero, then the request succeeds
+	//    and the allocation's time-to-expiry is set to the "desired
+	//    lifetime".
+
+	if (desiredLifetime > 0)
+		setLifetime(desiredLifetime);
+
+	// If the request succeeds, then the server sends a success response
+	// containing:
+
+	// o  A LIFETIME attribute containing the current value of the time-to-
+	//    expiry timer.
+
+	//    NOTE: A server need not do anything special to implement
+	//    idempotency of Refresh requests over UDP using the "stateless
+	//    stack approach".  Retransmitted Refresh requests with a non-zero
+	//    "desired lifetime" will simply refresh the allocation.  A
+	//    retransmitted Refresh request with a zero "desired lifetime" will
+	//    cause a 437 (Allocation Mismatch) response if the allocation has
+	//    already been deleted, but the client will treat this as equivalent
+	//    to a success response (see below).
+	
+	_server.respondRefresh(request, desiredLifetime);
+	//request.socket->send(response, request.remoteAddress);
+
+	// Delete the allocation after responding
+	if (desiredLifetime == 0)
+		delete this;
+}
+
+
+void ServerAllocation::handleCreatePermission(Request& request) 
+{	
+	TraceL << "Handle Create Permission" << endl;
+
+	// 9.2. Receiving a CreatePermission Request
+	// 
+	// When the server receives the CreatePermission request, it processes
+	// as per Section 4 plus the specific rules mentioned here.
+	// 
+	// The message is checked for validity.  The CreatePermission request
+	// MUST contain at least one XOR-PEER-ADDRESS attribute and MAY contain
+	// multiple such attributes.  If no such attribute exists, or if any of
+	// these attributes are invalid, then a 400 (Bad Request) error is
+	// returned.  If the request is valid, but the server is unable to
+	// satisfy the request due to some capacity limit or similar, then a 508
+	// (Insufficient Capacity) error is returned.
+	// 
+	// The server MAY impose restrictions on the IP address allowed in the
+	// XOR-PEER-ADDRESS attribute -- if a value is not allowed, the server
+	// rejects the request with a 403 (Forbidden) error.
+	// 
+	// If the message is valid and the server is capable of carrying out the
+	// request, then the server installs or refreshes a permission for the
+	// IP address contained in each XOR-PEER-ADDRESS attribute as described
+	// in Section 8.  The port portion of each attribute is ignored and may
+	// be any arbitrary value.
+	// 
+	// The server then responds with a CreatePermission success response.
+	// There are no mandatory attributes in the success response.
+	// 
+	//   NOTE: A server need not do anything special to implement
+	//   idempotency of CreatePermission requests over UDP using the
+	//   "stateless stack approach".  Retransmitted CreatePermission
+	//   requests will simply refresh the permissions.			
+	//
+    for (int i = 0; i < _server.options().allocationMaxPermissions; i++) {
+		auto peerAttr = request.get<stun::XorPeerAddress>(i);
+		if (!peerAttr || (peerAttr && peerAttr->family() != 1)) {
+			if (i == 0) {
+				_server.respondError(request, 400, "Bad Request");
+				return;
+			}
+			else
+				break;	
+		}
+		addPermission(std::string(peerAttr->address().host()));
+	}
+	
+	_server.respondCreatePermission(request);
+	//request.socket->send(response, request.remoteAddress);
+}
+
+
+void ServerAllocation::handleChannelData(UInt16 /* channel */, const char* /* data */, std::size_t /* size */) 
+{
+	_server.stats().drop(ServerStats::InvalidMessage);
+}
+
+
+void ServerAllocation::setLifetime(Int64 lifetime)
+{
+	IAllocation::setLifetime(lifetime);
+	_server.wheel().schedule(_expiry, timeRemaining() * 1000);
+}
+
+
+void ServerAllocation::addPermission(const std::string& ip)
+{
+	IAllocation::addPermission(ip);
+	if (!_permissionExpiry.scheduled())
+		_server.wheel().schedule(_permissionExpiry, PERMISSION_LIFETIME);
+}
+
+
+void ServerAllocation::expire()
+{
+	if (_deleted)
+		return;
+
+	_deleted = true;
+	_server.wheel().schedule(_expiry, 0);
+}
+
+
+void ServerAllocation::onExpiry()
+{
+	if (IAllocation::deleted()) {
+		TraceL << "Allocation expired: " << _tuple << endl;
+		_server.stats().allocationExpired();
+		delete this; // bye bye
+		return;
+	}
+
+	_server.wheel().schedule(_expiry, timeRemaining() * 1000);
+}
+
+
+void ServerAllocation::onPermissionExpiry()
+{
+	removeExpiredPermissions();
+	if (_permissions.empty())
+		return;
+
+	UInt64 next = _permissions.front().expiresAt;
+	for (auto it = _permissions.begin(); it != _permissions.end(); ++it)
+		next = std::min<UInt64>(next, (*it).expiresAt);
+	_server.wheel().schedule(_permissionExpiry, 
+		static_cast<Int64>(next - uv_now(uv::defaultLoop())));
+}
+
+
+Int64 ServerAllocation::maxTimeRemaining() const
+{
+	Int64 elapsed =  static_cast<Int64>(time(0) - _createdAt);
+	return elapsed > _maxLifetime ? 0 : _maxLifetime - elapsed;
+}
+
+
+Int64 ServerAllocation::timeRemaining() const
+{
+	//Mutex::ScopedLock lock(_mutex);	
+	return min<Int64>(IAllocation::timeRemaining(), maxTimeRemaining());
+}
+
+
+Server& ServerAllocation::server()
+{
+	//Mutex::ScopedLock lock(_mutex);
+	return _server;
+}
+
+
+void ServerAllocation::print(std::ostream& os) const
+{ 
+	os << "ServerAllocation[" 
+		<< "\r\tTuple=" << _tuple
+		<< "\r\tUsername=" << username()
+		<< "\n\tBandwidth Limit=" << bandwidthLimit()
+		<< "\n\tBandwidth Used=" << bandwidthUsed()
+		<< "\n\tBandwidth Remaining=" << bandwidthRemaining()
+		<< "\n\tBase Time Remaining=" << IAllocation::timeRemaining()
+		<< "\n\tTime Remaining=" << timeRemaining()
+		<< "\n\tMax Time Remaining=" << maxTimeRemaining()
+		<< "\n\tDeletable=" << IAllocation::deleted()
+		<< "\n\tExpired=" << expired()
+		<< "]"
+		<< endl;
+}
+
+
+} } // namespace scy::turn
\ No newline at end of file
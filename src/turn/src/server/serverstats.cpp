@@ -0,0 +1,240 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#include "scy/turn/server/serverstats.h"
+
+
+using namespace std;
+
+
+namespace scy {
+namespace turn {
+
+
+LatencyHistogram::LatencyHistogram() :
+	_count(0),
+	_sum(0)
+{
+	for (int i = 0; i < NumBuckets; i++)
+		_buckets[i] = 0;
+}
+
+
+void LatencyHistogram::record(UInt64 usec)
+{
+	int index = 0;
+	while (index < NumBuckets - 1 && bucketBound(index) < usec)
+		index++;
+	_buckets[index].fetch_add(1, memory_order_relaxed);
+	_count.fetch_add(1, memory_order_relaxed);
+	_sum.fetch_add(usec, memory_order_relaxed);
+}
+
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+{
+	Snapshot snap;
+	for (int i = 0; i < NumBuckets; i++)
+		snap.buckets[i] = _buckets[i].load(memory_order_relaxed);
+	snap.count = _count.load(memory_order_relaxed);
+	snap.sum = _sum.load(memory_order_relaxed);
+	return snap;
+}
+
+
+UInt64 LatencyHistogram::bucketBound(int index)
+{
+	return UInt64(1) << index;
+}
+
+
+//
+// Server Stats
+//
+
+
+ServerStats::ServerStats() :
+	_authFailures(0),
+	_allocationsActive(0),
+	_allocationsCreated(0),
+	_allocationsExpired(0),
+	_permissionMisses(0)
+{
+	for (int i = 0; i < NumMethods; i++)
+		_requests[i] = 0;
+	for (int i = 0; i < NumDirections; i++) {
+		_relayedBytes[i] = 0;
+		_relayedPackets[i] = 0;
+	}
+	for (int i = 0; i < NumDropReasons; i++)
+		_drops[i] = 0;
+}
+
+
+ServerStats::Snapshot ServerStats::snapshot() const
+{
+	Snapshot snap;
+	for (int i = 0; i < NumMethods; i++)
+		snap.requests[i] = _requests[i].load(memory_order_relaxed);
+	snap.authFailures = _authFailures.load(memory_order_relaxed);
+	snap.allocationsActive = _allocationsActive.load(memory_order_relaxed);
+	snap.allocationsCreated = _allocationsCreated.load(memory_order_relaxed);
+	snap.allocationsExpired = _allocationsExpired.load(memory_order_relaxed);
+	for (int i = 0; i < NumDirections; i++) {
+		snap.relayedBytes[i] = _relayedBytes[i].load(memory_order_relaxed);
+		snap.relayedPackets[i] = _relayedPackets[i].load(memory_order_relaxed);
+	}
+	snap.permissionMisses = _permissionMisses.load(memory_order_relaxed);
+	for (int i = 0; i < NumDropReasons; i++)
+		snap.drops[i] = _drops[i].load(memory_order_relaxed);
+	snap.latency = _latency.snapshot();
+	return snap;
+}
+
+
+void ServerStats::writeJSON(std::ostream& os) const
+{
+	Snapshot snap = snapshot();
+
+	os << "{\"requests\":{";
+	bool first = true;
+	for (int i = 0; i < NumMethods; i++) {
+		if (!methodName(i))
+			continue;
+		os << (first ? "" : ",") << "\"" << methodName(i) << "\":" << snap.requests[i];
+		first = false;
+	}
+	os << "},\"authFailures\":" << snap.authFailures
+		<< ",\"allocations\":{\"active\":" << snap.allocationsActive
+		<< ",\"created\":" << snap.allocationsCreated
+		<< ",\"expired\":" << snap.allocationsExpired << "}"
+		<< ",\"relayed\":{";
+	for (int i = 0; i < NumDirections; i++) {
+		os << (i ? "," : "") << "\"" << directionName(i) << "\":{\"bytes\":" 
+			<< snap.relayedBytes[i] << ",\"packets\":" << snap.relayedPackets[i] << "}";
+	}
+	os << "},\"permissionMisses\":" << snap.permissionMisses
+		<< ",\"drops\":{";
+	for (int i = 0; i < NumDropReasons; i++)
+		os << (i ? "," : "") << "\"" << dropReasonName(i) << "\":" << snap.drops[i];
+	os << "},\"requestLatency\":{\"count\":" << snap.latency.count
+		<< ",\"sumMicroseconds\":" << snap.latency.sum
+		<< ",\"buckets\":[";
+	for (int i = 0; i < LatencyHistogram::NumBuckets; i++) {
+		os << (i ? "," : "") << "{\"le\":";
+		if (i < LatencyHistogram::NumBuckets - 1)
+			os << LatencyHistogram::bucketBound(i);
+		else
+			os << "null";
+		os << ",\"count\":" << snap.latency.buckets[i] << "}";
+	}
+	os << "]}}";
+}
+
+
+void ServerStats::writePrometheus(std::ostream& os) const
+{
+	Snapshot snap = snapshot();
+
+	os << "# TYPE turn_requests_total counter\n";
+	for (int i = 0; i < NumMethods; i++) {
+		if (methodName(i))
+			os << "turn_requests_total{method=\"" << methodName(i) << "\"} " << snap.requests[i] << "\n";
+	}
+
+	os << "# TYPE turn_auth_failures_total counter\n"
+		<< "turn_auth_failures_total " << snap.authFailures << "\n"
+		<< "# TYPE turn_allocations_active gauge\n"
+		<< "turn_allocations_active " << snap.allocationsActive << "\n"
+		<< "# TYPE turn_allocations_created_total counter\n"
+		<< "turn_allocations_created_total " << snap.allocationsCreated << "\n"
+		<< "# TYPE turn_allocations_expired_total counter\n"
+		<< "turn_allocations_expired_total " << snap.allocationsExpired << "\n";
+
+	os << "# TYPE turn_relayed_bytes_total counter\n";
+	for (int i = 0; i < NumDirections; i++)
+		os << "turn_relayed_bytes_total{direction=\"" << directionName(i) << "\"} " << snap.relayedBytes[i] << "\n";
+	os << "# TYPE turn_relayed_packets_total counter\n";
+	for (int i = 0; i < NumDirections; i++)
+		os << "turn_relayed_packets_total{direction=\"" << directionName(i) << "\"} " << snap.relayedPackets[i] << "\n";
+
+	os << "# TYPE turn_permission_misses_total counter\n"
+		<< "turn_permission_misses_total " << snap.permissionMisses << "\n";
+
+	os << "# TYPE turn_drops_total counter\n";
+	for (int i = 0; i < NumDropReasons; i++)
+		os << "turn_drops_total{reason=\"" << dropReasonName(i) << "\"} " << snap.drops[i] << "\n";
+
+	// Prometheus buckets are cumulative and measured in seconds
+	os << "# TYPE turn_request_duration_seconds histogram\n";
+	UInt64 cumulative = 0;
+	for (int i = 0; i < LatencyHistogram::NumBuckets - 1; i++) {
+		cumulative += snap.latency.buckets[i];
+		os << "turn_request_duration_seconds_bucket{le=\"" 
+			<< (LatencyHistogram::bucketBound(i) / 1e6) << "\"} " << cumulative << "\n";
+	}
+	os << "turn_request_duration_seconds_bucket{le=\"+Inf\"} " << snap.latency.count << "\n"
+		<< "turn_request_duration_seconds_sum " << (snap.latency.sum / 1e6) << "\n"
+		<< "turn_request_duration_seconds_count " << snap.latency.count << "\n";
+}
+
+
+const char* ServerStats::methodName(int method)
+{
+	switch (method) {
+	case stun::Message::Binding:			return "binding";
+	case stun::Message::Allocate:			return "allocate";
+	case stun::Message::Refresh:			return "refresh";
+	case stun::Message::SendIndication:		return "send";
+	case stun::Message::DataIndication:		return "data";
+	case stun::Message::CreatePermission:	return "create_permission";
+	case stun::Message::ChannelBind:		return "channel_bind";
+	case stun::Message::Connect:			return "connect";
+	case stun::Message::ConnectionBind:		return "connection_bind";
+	case stun::Message::ConnectionAttempt:	return "connection_attempt";
+	}
+	return nullptr;
+}
+
+
+const char* ServerStats::directionName(int dir)
+{
+	switch (dir) {
+	case ToPeer:	return "to_peer";
+	case ToClient:	return "to_client";
+	}
+	return "unknown";
+}
+
+
+const char* ServerStats::dropReasonName(int reason)
+{
+	switch (reason) {
+	case QuotaReached:		return "quota_reached";
+	case RateLimited:		return "rate_limited";
+	case QueueFull:			return "queue_full";
+	case NoAllocation:		return "no_allocation";
+	case InvalidMessage:	return "invalid_message";
+	}
+	return "unknown";
+}
+
+
+} } // namespace scy::turn
@@ -0,0 +1,250 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#include "scy/turn/server/splicerelay.h"
+#include "scy/logger.h"
+
+#include <cerrno>
+#include <cstring>
+
+#if __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#endif
+
+
+using namespace std;
+
+
+namespace scy {
+namespace turn {
+
+
+// The pipe capacity, which bounds the bytes moved by a single splice call.
+const std::size_t kSplicePipeSize = 256 * 1024;
+
+
+SpliceRelay::SpliceRelay(int clientFd, int peerFd, uv::Loop* loop) :
+	_loop(loop),
+	_active(false)
+{
+	_fds[0] = clientFd;
+	_fds[1] = peerFd;
+	for (int i = 0; i < 2; i++) {
+		_dups[i] = -1;
+		_polls[i] = nullptr;
+		_channels[i].source = i;
+		_channels[i].pipe[0] = -1;
+		_channels[i].pipe[1] = -1;
+		_channels[i].pending = 0;
+		_channels[i].eof = false;
+		_channels[i].done = false;
+	}
+}
+
+
+SpliceRelay::~SpliceRelay()
+{
+	stop();
+}
+
+
+bool SpliceRelay::supported()
+{
+#if __linux__
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+bool SpliceRelay::start()
+{
+#if __linux__
+	assert(!_active);
+	for (int i = 0; i < 2; i++) {
+		if (pipe2(_channels[i].pipe, O_NONBLOCK | O_CLOEXEC) < 0 ||
+			(_dups[i] = fcntl(_fds[i], F_DUPFD_CLOEXEC, 0)) < 0) {
+			WarnL << "Cannot create splice relay: " << strerror(errno) << endl;
+			stop();
+			return false;
+		}
+		fcntl(_channels[i].pipe[1], F_SETPIPE_SZ, kSplicePipeSize);
+	}
+	for (int i = 0; i < 2; i++) {
+		_polls[i] = new uv::Handle(_loop, new uv_poll_t);
+		_polls[i]->ptr()->data = this;
+		uv_poll_init(_loop, _polls[i]->ptr<uv_poll_t>(), _dups[i]);
+	}
+	_active = true;
+	updatePoll(0);
+	updatePoll(1);
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+void SpliceRelay::stop()
+{
+#if __linux__
+	_active = false;
+	for (int i = 0; i < 2; i++) {
+		if (_polls[i]) {
+			delete _polls[i];
+			_polls[i] = nullptr;
+		}
+		if (_dups[i] != -1) {
+			// The original descriptor keeps the socket open, so remove
+			// the duplicate from epoll explicitly before closing it
+			struct epoll_event e;
+			epoll_ctl(uv_backend_fd(_loop), EPOLL_CTL_DEL, _dups[i], &e);
+			::close(_dups[i]);
+			_dups[i] = -1;
+		}
+		for (int j = 0; j < 2; j++) {
+			if (_channels[i].pipe[j] != -1) {
+				::close(_channels[i].pipe[j]);
+				_channels[i].pipe[j] = -1;
+			}
+		}
+		_channels[i].pending = 0;
+		_channels[i].eof = false;
+		_channels[i].done = false;
+	}
+#endif
+}
+
+
+bool SpliceRelay::active() const
+{
+	return _active;
+}
+
+
+bool SpliceRelay::transfer(Channel& channel)
+{
+#if __linux__
+	// Fill the pipe from the source socket, then drain it
+	// into the destination until either would block
+	while (channel.pending == 0 && !channel.eof) {
+		ssize_t n = splice(_dups[channel.source], nullptr, channel.pipe[1], nullptr, 
+			kSplicePipeSize, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+		if (n == 0) {
+			// The source has shut down its side, pass it on
+			channel.eof = true;
+			return flush(channel);
+		}
+		if (n < 0)
+			return errno == EAGAIN || errno == EINTR;
+
+		channel.pending += n;
+		if (!flush(channel))
+			return false;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+bool SpliceRelay::flush(Channel& channel)
+{
+#if __linux__
+	Direction dir = channel.source == 0 ? ToPeer : ToClient;
+	int dest = 1 - channel.source;
+	while (channel.pending > 0) {
+		ssize_t n = splice(channel.pipe[0], nullptr, _dups[dest], nullptr, 
+			channel.pending, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+		if (n < 0)
+			return errno == EAGAIN || errno == EINTR;
+		if (n == 0)
+			return false;
+
+		channel.pending -= n;
+		if (Relayed && !Relayed(dir, n))
+			return false;
+	}
+
+	// Once the pipe is drained after the source reached EOF, shut
+	// down the destination's write side so it sees the EOF too, 
+	// while the other direction keeps relaying.
+	if (channel.eof && !channel.done) {
+		channel.done = true;
+		if (::shutdown(_dups[dest], SHUT_WR) < 0 && errno != ENOTCONN)
+			return false;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+void SpliceRelay::updatePoll(int index)
+{
+	// Read from an endpoint while its outgoing pipe is empty, and
+	// wait for it to become writable while its incoming pipe is not
+	Channel& outgoing = _channels[index == 0 ? ToPeer : ToClient];
+	Channel& incoming = _channels[index == 0 ? ToClient : ToPeer];
+	int events = 0;
+	if (outgoing.pending == 0 && !outgoing.eof)
+		events |= UV_READABLE;
+	if (incoming.pending > 0)
+		events |= UV_WRITABLE;
+
+	uv_poll_start(_polls[index]->ptr<uv_poll_t>(), events, [](uv_poll_t* handle, int status, int events) {
+		reinterpret_cast<SpliceRelay*>(handle->data)->onPoll(handle, status, events);
+	});
+}
+
+
+void SpliceRelay::onPoll(uv_poll_t* handle, int status, int events)
+{
+	int index = handle == _polls[0]->ptr<uv_poll_t>() ? 0 : 1;
+	Channel& outgoing = _channels[index == 0 ? ToPeer : ToClient];
+	Channel& incoming = _channels[index == 0 ? ToClient : ToPeer];
+
+	bool ok = status == 0;
+	if (ok && (events & UV_WRITABLE))
+		ok = flush(incoming);
+	if (ok && (events & UV_READABLE))
+		ok = transfer(outgoing);
+	if (!ok || (outgoing.done && incoming.done)) {
+		// Call a copy since the callback may delete the relay
+		stop();
+		std::function<void()> closed(Closed);
+		if (closed)
+			closed();
+		return;
+	}
+
+	// Either endpoint's interest may have changed
+	updatePoll(0);
+	updatePoll(1);
+}
+
+
+} } // namespace scy::turn
@@ -0,0 +1,385 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "scy/turn/server/tcpconnectionpair.h"
+#include "scy/turn/server/tcpallocation.h"
+#include "scy/turn/server/server.h"
+#include "scy/crypto/crypto.h"
+
+#include <algorithm>
+
+
+using namespace std;
+
+
+namespace scy {
+namespace turn {
+
+	
+TCPConnectionPair::TCPConnectionPair(TCPAllocation& allocation) :
+	allocation(allocation), client(nullptr), peer(nullptr), earlyPeerData(0),
+	connectionID(util::randomNumber()), isDataConnection(false), 
+	clientThrottled(0), peerThrottled(0)
+{		
+	while (!allocation.pairs().add(connectionID, this, false)) {
+		connectionID = util::randomNumber();
+	}
+	throttleTimer.Timeout += sdelegate(this, &TCPConnectionPair::onThrottleTimer);
+	timeout.callback = [this]() { onTimeout(); };
+	TraceLS(this) << "Create: " << connectionID << endl;	
+}
+
+
+TCPConnectionPair::~TCPConnectionPair() 
+{		
+	TraceLS(this) << "Destroy: " << connectionID << endl;	
+
+	throttleTimer.Timeout -= sdelegate(this, &TCPConnectionPair::onThrottleTimer);
+	throttleTimer.stop();
+
+	// Release the relay before the sockets it duplicates
+	relay.reset();
+
+	if (client) {
+		//assert(client->base().refCount() == 2);
+		client->Recv -= sdelegate(this, &TCPConnectionPair::onClientDataReceived);
+		client->Close -= sdelegate(this, &TCPConnectionPair::onConnectionClosed);
+		client->close();
+	}
+	if (peer) {		
+		//assert(peer->base().refCount() == 1);
+		peer->Recv -= sdelegate(this, &TCPConnectionPair::onPeerDataReceived);
+		peer->Connect -= sdelegate(this, &TCPConnectionPair::onPeerConnectSuccess);
+		peer->Error -= sdelegate(this, &TCPConnectionPair::onPeerConnectError);
+		peer->Close -= sdelegate(this, &TCPConnectionPair::onConnectionClosed);
+		peer->close();
+	}
+
+	assert(allocation.pairs().exists(connectionID));
+	allocation.pairs().remove(connectionID);
+}
+
+
+bool TCPConnectionPair::doPeerConnect(const net::Address& peerAddr)
+{	
+	try {
+		assert(!transactionID.empty());
+		peer = std::make_shared<net::TCPSocket>();
+		peer->opaque = this;
+		peer->Close += sdelegate(this, &TCPConnectionPair::onConnectionClosed);
+
+		// Start receiving early media
+		peer->Recv += sdelegate(this, &TCPConnectionPair::onPeerDataReceived);
+
+		// Connect request specific events
+		peer->Connect += sdelegate(this, &TCPConnectionPair::onPeerConnectSuccess);
+		peer->Error += sdelegate(this, &TCPConnectionPair::onPeerConnectError);
+	
+		client->connect(peerAddr);
+	} 
+	catch (std::exception& exc) {
+		ErrorLS(this) << "Peer connect error: " << exc.what() << endl;
+		assert(0);
+		return false;
+	}
+	return true;
+}
+
+
+void TCPConnectionPair::setPeerSocket(const net::TCPSocket::Ptr& socket)
+{	
+	TraceLS(this) << "Set peer socket: " 
+		<< connectionID << ": " << socket->peerAddress() << endl;	
+		//<< ": " << socket./*base().*/refCount() 
+
+	assert(peer == nullptr);
+	//assert(socket./*base().*/refCount() == 1);
+	peer = socket;
+	peer->Close += sdelegate(this, &TCPConnectionPair::onConnectionClosed);
+	
+	// Receive and buffer early media from peer
+	peer->Recv += sdelegate(this, &TCPConnectionPair::onPeerDataReceived);	
+	net::setServerSocketBufSize<uv_tcp_t>(*socket.get(), SERVER_SOCK_BUF_SIZE); // TODO: make option
+}
+
+
+void TCPConnectionPair::setClientSocket(const net::TCPSocket::Ptr& socket)
+{
+	TraceLS(this) << "Set client socket: "
+		<< connectionID << ": " << socket->peerAddress()  << endl;	
+		//<< ": " << socket./*base().*/refCount()
+	assert(client == nullptr);
+	//assert(socket./*base().*/refCount() == 2);
+	client = socket;
+	client->Close += sdelegate(this, &TCPConnectionPair::onConnectionClosed);
+	net::setServerSocketBufSize<uv_tcp_t>(*socket.get(), SERVER_SOCK_BUF_SIZE); // TODO: make option
+}
+
+
+bool TCPConnectionPair::makeDataConnection()
+{
+	TraceLS(this) << "Make data connection: " << connectionID << endl;	
+	if (!peer || !client)
+		return false;
+
+	peer->Recv += sdelegate(this, &TCPConnectionPair::onPeerDataReceived);
+	client->Recv += sdelegate(this, &TCPConnectionPair::onClientDataReceived);	
+	
+	// Relase and unbind the client socket from the server.
+	// The client socket instance, events and data will be
+	// managed by the TCPConnectionPair from now on.
+	allocation.server().releaseTCPSocket(client.get());
+			
+	// The ConnectionBind request has been received
+	timeout.cancel();
+			
+	// Send early data from peer to client
+	if (earlyPeerData.size()) {
+		TraceLS(this) << "Flushing early media: " << earlyPeerData.size() << endl;	
+		client->send(earlyPeerData.data(), earlyPeerData.size());
+		earlyPeerData.clear();
+	}
+
+	isDataConnection = true;
+	startSplice();
+	return true;
+}
+
+
+bool TCPConnectionPair::startSplice()
+{
+	// Spliced data bypasses the rate shaper, and must not
+	// overtake data already queued by libuv
+	if (!allocation.server().options().enableSplice || 
+		!SpliceRelay::supported() || 
+		allocation.shapingOptions().enabled() ||
+		client->ptr<uv_stream_t>()->write_queue_size > 0 || 
+		peer->ptr<uv_stream_t>()->write_queue_size > 0)
+		return false;
+
+	relay.reset(new SpliceRelay(
+		nativeSocketFd(client->ptr<uv_tcp_t>()), 
+		nativeSocketFd(peer->ptr<uv_tcp_t>())));
+	relay->Relayed = [this](SpliceRelay::Direction dir, std::size_t size) {
+		allocation.updateUsage(size);
+		if (allocation.deleted()) {
+			allocation.server().stats().drop(ServerStats::QuotaReached);
+			allocation.expire();
+			return false;
+		}
+		allocation.server().stats().relayed(dir == SpliceRelay::ToPeer ? 
+			ServerStats::ToPeer : ServerStats::ToClient, size);
+		return true;
+	};
+	relay->Closed = [this]() {
+		TraceLS(this) << "Splice relay closed: " << connectionID << endl;
+		delete this;
+	};
+
+	client->readStop();
+	peer->readStop();
+	if (!relay->start()) {
+		relay.reset();
+		client->readStart();
+		peer->readStart();
+		return false;
+	}
+
+	TraceLS(this) << "Splicing relay: " << connectionID << endl;
+	return true;
+}
+
+
+void TCPConnectionPair::onPeerDataReceived(void*, const MutableBuffer& buffer, const net::Address& peerAddress)
+{
+	//assert(pkt.buffer.position() == 0);
+	//if (pkt.buffer.available() < 300)
+	//	TraceLS(this) << "Peer => Client: " << pkt.buffer << endl;	
+	//auto socket = reinterpret_cast<net::Socket*>(sender);		
+	//char* buf = bufferCast<char*>(buf);
+	
+	//Buffer& buf = pkt.buffer;
+	const char* buf = bufferCast<const char*>(buffer);
+	std::size_t len = buffer.size();
+	if (client) {	
+		
+		allocation.updateUsage(len);
+		if (allocation.deleted()) {
+			allocation.server().stats().drop(ServerStats::QuotaReached);
+			allocation.expire();
+			return;
+		}
+
+		//assert(buf.position() == 0);
+		client->send(buf, len);
+		allocation.server().stats().relayed(ServerStats::ToClient, len);
+		throttle(*peer, len);
+	}
+
+	// Flash policy requests
+	// TODO: Handle elsewhere? Bloody flash...
+	else if (len == 23 && (strcmp(buf, "<policy-file-request/>") == 0)) {
+		TraceLS(this) << "Handle flash policy" << endl;
+		std::string policy("<?xml version=\"1.0\"?><cross-domain-policy><allow-access-from domain=\"*\" to-ports=\"*\" /></cross-domain-policy>");
+		//assert(peer->get() == pkt.info->socket);
+		peer->send(policy.c_str(), policy.length() + 1);
+		peer->close();
+	}
+	
+	// Buffer early media
+	// TODO: Make buffer size server option
+	else {
+		size_t maxSize = allocation.server().options().earlyMediaBufferSize;
+		DebugLS(this) << "Buffering early data: " << len << endl;
+//#ifdef _DEBUG
+//		DebugLS(this) << "Printing early data: " << std::string(buf, len) << endl;
+//#endif
+		if (len > maxSize)
+			WarnL << "Dropping early media: Oversize packet: " << len << endl;
+		if (earlyPeerData.size() > maxSize)
+			WarnL << "Dropping early media: Buffer at capacity >= " << maxSize << endl;
+
+		//earlyPeerData.append(static_cast<const char*>(pkt.data()), len);
+		earlyPeerData.insert(earlyPeerData.end(), buf, buf + len); 
+	}
+}
+
+
+void TCPConnectionPair::onClientDataReceived(void*, const MutableBuffer& buffer, const net::Address& peerAddress)
+{
+	//assert(packet.buffer.position() == 0);
+	//if (packet.size() < 300)
+	//	TraceLS(this) << "Client => Peer: " << packet.buffer << endl;	
+
+	if (peer) {
+		allocation.updateUsage(buffer.size());
+		if (allocation.deleted()) {
+			allocation.server().stats().drop(ServerStats::QuotaReached);
+			allocation.expire();
+			return;
+		}
+
+		peer->send(bufferCast<char*>(buffer), buffer.size());
+		allocation.server().stats().relayed(ServerStats::ToPeer, buffer.size());
+		throttle(*client, buffer.size());
+	}
+}
+
+
+void TCPConnectionPair::throttle(net::TCPSocket& source, std::size_t size)
+{
+	// Stream data can't be dropped without corrupting the stream, so 
+	// data is always relayed and the source is paused while in debt.
+	if (allocation.admit(size))
+		return;
+
+	allocation.consume(size);
+	source.readStop();
+	if (&source == client.get())
+		clientThrottled = size;
+	else
+		peerThrottled = size;
+	startThrottleTimer();
+}
+
+
+void TCPConnectionPair::onThrottleTimer(void*)
+{
+	// Each side stays paused until the limits would admit the read
+	// which paused it, so a small read does not wake a large one.
+	if (clientThrottled && allocation.available(clientThrottled)) {
+		clientThrottled = 0;
+		if (client && !client->closed())
+			client->readStart();
+	}
+	if (peerThrottled && allocation.available(peerThrottled)) {
+		peerThrottled = 0;
+		if (peer && !peer->closed())
+			peer->readStart();
+	}
+	if (clientThrottled || peerThrottled)
+		startThrottleTimer();
+}
+
+
+void TCPConnectionPair::startThrottleTimer()
+{
+	UInt64 delay = 0;
+	if (clientThrottled)
+		delay = allocation.admitDelay(clientThrottled);
+	if (peerThrottled) {
+		UInt64 peerDelay = allocation.admitDelay(peerThrottled);
+		delay = clientThrottled ? std::min<UInt64>(delay, peerDelay) : peerDelay;
+	}
+	throttleTimer.start(std::max<Int64>(static_cast<Int64>(delay), 1), 0);
+}
+
+
+void TCPConnectionPair::onPeerConnectSuccess(void* sender)
+{
+	TraceLS(this) << "Peer Connect request success" << endl;	
+	assert(sender == &peer);
+	peer->Connect -= sdelegate(this, &TCPConnectionPair::onPeerConnectSuccess);
+	peer->Error -= sdelegate(this, &TCPConnectionPair::onPeerConnectError);
+		
+	// If no ConnectionBind request associated with this peer data
+	// connection is received after 30 seconds, the peer data connection
+	// MUST be closed.
+
+	allocation.sendPeerConnectResponse(this, true);
+
+	// TODO: Ensure this is implemented properly
+	startTimeout();
+}
+
+
+void TCPConnectionPair::onPeerConnectError(void* sender, const Error& error)
+{
+	TraceLS(this) << "Peer Connect request error: " << error.message << endl;	
+	assert(sender == &peer);
+	allocation.sendPeerConnectResponse(this, false);
+
+	// The TCPConnectionPair will be deleted on next call to onConnectionClosed
+}
+	
+
+void TCPConnectionPair::onConnectionClosed(void* sender)
+{
+	TraceLS(this) << "Connection pair socket closed: " << connectionID << ": " << sender << endl;
+	delete this; // fail
+}
+
+
+void TCPConnectionPair::startTimeout()
+{
+	allocation.server().wheel().schedule(timeout, CONNECTION_BIND_TIMEOUT);
+}
+
+
+void TCPConnectionPair::onTimeout()
+{
+	if (isDataConnection)
+		return;
+
+	TraceLS(this) << "ConnectionBind request timed out: " << connectionID << endl;
+	delete this;
+}
+
+
+} } // namespace scy::turn
\ No newline at end of file
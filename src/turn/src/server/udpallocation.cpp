@@ -0,0 +1,416 @@
+//
+// LibSourcey
+// Copyright (C) 2005, Sourcey <http://sourcey.com>
+//
+// LibSourcey is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// LibSourcey is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "scy/turn/server/udpallocation.h"
+#include "scy/turn/server/server.h"
+#include "scy/net/udpsocket.h"
+#include "scy/buffer.h"
+#include "scy/logger.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+
+using namespace std;
+
+
+namespace scy {
+namespace turn {
+
+
+UDPAllocation::UDPAllocation(Server& server,
+                             const FiveTuple& tuple, 
+                             const std::string& username, 
+                             const UInt32& lifetime) : 
+	ServerAllocation(server, tuple, username, lifetime),
+	//_relaySocket(new net::UDPSocket) //server.reactor(), server.runner()
+	_queueSize(0)
+{
+	// Handle data from the relay socket directly from the allocation.
+	// This will remove the need for allocation lookups when receiving
+	// data from peers.
+	_relaySocket.bind(net::Address(server.options().listenAddr.host(), 0));		
+	_relaySocket.Recv += sdelegate(this, &UDPAllocation::onPeerDataReceived);
+	_queueTimer.Timeout += sdelegate(this, &UDPAllocation::onQueueTimer);
+
+	TraceL << " Initializing on address: " << _relaySocket.address() << endl;
+}
+
+
+UDPAllocation::~UDPAllocation() 
+{
+	TraceL << "Destroy" << endl;	
+	_relaySocket.Recv -= sdelegate(this, &UDPAllocation::onPeerDataReceived);
+	_relaySocket.close();
+	_queueTimer.Timeout -= sdelegate(this, &UDPAllocation::onQueueTimer);
+	_queueTimer.stop();
+}
+
+
+bool UDPAllocation::handleRequest(Request& request) 
+{	
+	TraceL << "Handle Request" << endl;	
+
+	if (!ServerAllocation::handleRequest(request)) {
+		if (request.methodType() == stun::Message::SendIndication)
+			handleSendIndication(request);
+		else if (request.methodType() == stun::Message::ChannelBind)
+			handleChannelBindRequest(request);
+		else
+			return false;
+	}
+	
+	return true; 
+}
+
+
+void UDPAllocation::handleSendIndication(Request& request) 
+{	
+	TraceL << "Handle Send Indication" << endl;
+
+	// The message is first checked for validity.  The Send indication MUST
+	// contain both an XOR-PEER-ADDRESS attribute and a DATA attribute.  If
+	// one of these attributes is missing or invalid, then the message is
+	// discarded.  Note that the DATA attribute is allowed to contain zero
+	// bytes of data.
+
+	auto peerAttr = request.get<stun::XorPeerAddress>();
+	if (!peerAttr || (peerAttr && peerAttr->family() != 1)) {
+		ErrorL << "Send Indication error: No Peer Address" << endl;
+		// silently discard...
+		return;
+	}
+
+	auto dataAttr = request.get<stun::Data>();
+	if (!dataAttr) {
+		ErrorL << "Send Indication error: No Data attribute" << endl;
+		// silently discard...
+		return;
+	}
+
+	// The Send indication may also contain the DONT-FRAGMENT attribute.  If
+	// the server is unable to set the DF bit on outgoing UDP datagrams when
+	// this attribute is present, then the server acts as if the DONT-
+	// FRAGMENT attribute is an unknown comprehension-required attribute
+	// (and thus the Send indication is discarded).
+
+	// The server also checks that there is a permission installed for the
+	// IP address contained in the XOR-PEER-ADDRESS attribute.  If no such
+	// permission exists, the message is discarded.  Note that a Send
+	// indication never causes the server to refresh the permission.
+
+	// The server MAY impose restrictions on the IP address and port values
+	// allowed in the XOR-PEER-ADDRESS attribute -- if a value is not
+	// allowed, the server silently discards the Send indication.
+	
+	net::Address peerAddress = peerAttr->address();
+	if (!hasPermission(peerAddress.host())) {
+		ErrorL << "Send Indication error: No permission for: " << peerAddress.host() << endl;
+		_server.stats().permissionMiss();
+		// silently discard...
+		return;
+	}
+
+	// If everything is OK, then the server forms a UDP datagram as follows:
+
+	// o  the source transport address is the relayed transport address of
+	//    the allocation, where the allocation is determined by the 5-tuple
+	//    on which the Send indication arrived;
+
+	// o  the destination transport address is taken from the XOR-PEER-
+	//    ADDRESS attribute;
+
+	// o  the data following the UDP header is the contents of the value
+	//    field of the DATA attribute.
+
+	// The handling of the DONT-FRAGMENT attribute (if present), is
+	// described in Section 12.
+
+	// The resulting UDP datagram is then sent to the peer.
+	
+	TraceL << "Relaying Send Indication: " 
+		<< "\r\tFrom: " << request.remoteAddress.toString()
+		<< "\r\tTo: " << peerAddress
+		<< endl;	
+
+	if (send(dataAttr->bytes(), dataAttr->size(), peerAddress) == -1) {
+		_server.respondError(request, 486, "Allocation Quota Reached");
+		delete this;
+	}
+}
+
+
+void UDPAllocation::handleChannelBindRequest(Request& request) 
+{	
+	TraceL << "Handle Channel Bind Request" << endl;
+
+	// The server checks the following:
+	// 
+	// o  The request contains both a CHANNEL-NUMBER and an XOR-PEER-ADDRESS
+	//    attribute;
+	// 
+	// o  The channel number is in the range 0x4000 through 0x7FFE 
+	//    (inclusive);
+	// 
+	// o  The channel number is not currently bound to a different transport
+	//    address (same transport address is OK);
+	// 
+	// o  The transport address is not currently bound to a different
+	//    channel number.
+	// 
+	// If any of these tests fail, the server replies with a 400 (Bad
+	// Request) error.
+
+	auto channelAttr = request.get<stun::ChannelNumber>();
+	auto peerAttr = request.get<stun::XorPeerAddress>();
+	if (!channelAttr || !peerAttr || peerAttr->family() != 1) {
+		_server.respondError(request, 400, "Bad Request");
+		return;
+	}
+
+	UInt16 number = static_cast<UInt16>(channelAttr->value() >> 16);
+	net::Address peerAddress = peerAttr->address();
+	if (number < MIN_CHANNEL_NUMBER || number > MAX_CHANNEL_NUMBER) {
+		_server.respondError(request, 400, "Bad Request");
+		return;
+	}
+
+	UInt64 now = uv_now(uv::defaultLoop());
+	_channels.erase(std::remove_if(_channels.begin(), _channels.end(), 
+		[now](const ChannelBinding& b) { return b.expiresAt <= now; }), _channels.end());
+
+	ChannelBinding* binding = getChannel(number);
+	if (binding != getChannel(peerAddress)) {
+		_server.respondError(request, 400, "Bad Request");
+		return;
+	}
+
+	if (!binding) {
+		if (_channels.size() >= static_cast<std::size_t>(_server.options().allocationMaxPermissions)) {
+			_server.respondError(request, 508, "Insufficient Capacity");
+			return;
+		}
+		ChannelBinding b;
+		b.number = number;
+		b.peerAddress = peerAddress;
+		_channels.push_back(b);
+		binding = &_channels.back();
+	}
+
+	// If the request is valid the server creates or refreshes the channel
+	// binding, and installs or refreshes the permission for the peer IP.
+	binding->expiresAt = now + CHANNEL_LIFETIME;
+	addPermission(peerAddress.host());
+	
+	TraceL << "Channel bound: " << number << ": " << peerAddress << endl;
+	_server.respondChannelBind(request);
+}
+
+
+void UDPAllocation::handleChannelData(UInt16 channel, const char* data, std::size_t size) 
+{	
+	// This is the relay hot path; avoid logging per message.
+	// Data on an unbound channel is silently discarded.
+	ChannelBinding* binding = getChannel(channel);
+	if (!binding) {
+		_server.stats().drop(ServerStats::InvalidMessage);
+		return;
+	}
+
+	if (send(data, size, binding->peerAddress) == -1)
+		expire();
+}
+
+
+UDPAllocation::ChannelBinding* UDPAllocation::getChannel(UInt16 number) 
+{	
+	UInt64 now = uv_now(uv::defaultLoop());
+	for (auto& binding : _channels) {
+		if (binding.number == number && binding.expiresAt > now)
+			return &binding;
+	}
+	return nullptr;
+}
+
+
+UDPAllocation::ChannelBinding* UDPAllocation::getChannel(const net::Address& peerAddress) 
+{	
+	UInt64 now = uv_now(uv::defaultLoop());
+	for (auto& binding : _channels) {
+		if (binding.peerAddress == peerAddress && binding.expiresAt > now)
+			return &binding;
+	}
+	return nullptr;
+}
+
+
+void UDPAllocation::onPeerDataReceived(void*, const MutableBuffer& buffer, const net::Address& peerAddress)
+{	
+	// This is the relay hot path; avoid logging per datagram.
+	if (!hasPermission(peerAddress.host())) {
+		_server.stats().permissionMiss();
+		return;
+	}
+
+	updateUsage(buffer.size());
+	
+	// Check that we have not exceeded out lifetime and bandwidth quota.
+	if (IAllocation::deleted()) {
+		_server.stats().drop(ServerStats::QuotaReached);
+		expire();
+		return;
+	}
+
+	const char* data = bufferCast<const char*>(buffer);
+	if (shape(data, buffer.size(), peerAddress, false))
+		sendToClient(data, buffer.size(), peerAddress);
+}
+
+
+void UDPAllocation::sendToClient(const char* data, std::size_t size, const net::Address& peerAddress)
+{	
+	ChannelBinding* binding = _channels.empty() ? nullptr : getChannel(peerAddress);
+	if (binding)
+		sendChannelData(binding->number, data, size);
+	else
+		sendDataIndication(data, size, peerAddress);
+}
+
+
+void UDPAllocation::sendDataIndication(const char* data, std::size_t size, const net::Address& peerAddress)
+{	
+	stun::Message message(stun::Message::Indication, stun::Message::DataIndication);
+		
+	// Try to use the externalIP value for the XorPeerAddress 
+	// attribute to overcome proxy and NAT issues.
+	std::string peerHost(server().options().externalIP);
+	if (peerHost.empty()) {
+		peerHost.assign(peerAddress.host());
+		assert(0 && "external IP not set");
+	}
+	
+	auto peerAttr = new stun::XorPeerAddress;
+	peerAttr->setAddress(net::Address(peerHost, peerAddress.port()));
+	message.add(peerAttr);
+
+	auto dataAttr = new stun::Data;
+	dataAttr->copyBytes(data, size);
+	message.add(dataAttr);
+		
+	server().udpSocket().sendPacket(message, _tuple.remote());
+	_server.stats().relayed(ServerStats::ToClient, size);
+}
+
+
+void UDPAllocation::sendChannelData(UInt16 channel, const char* data, std::size_t size)
+{	
+	// The header and payload go out as one datagram without copying.
+	char header[CHANNEL_DATA_HEADER_SIZE];
+	writeChannelDataHeader(header, channel, size);
+	ConstBuffer buffers[2] = { ConstBuffer(header, sizeof(header)), ConstBuffer(data, size) };
+	server().udpSocket().sendBuffers(buffers, 2, _tuple.remote());
+	_server.stats().relayed(ServerStats::ToClient, size);
+}
+
+
+int UDPAllocation::send(const char* data, std::size_t size, const net::Address& peerAddress)
+{
+	updateUsage(size);
+	
+	// Check that we have not exceeded our lifetime and bandwidth quota.
+	if (IAllocation::deleted()) {
+		WarnL << "Send indication dropped: Allocation quota reached" << endl;
+		_server.stats().drop(ServerStats::QuotaReached);
+		return -1;
+	}
+
+	if (!shape(data, size, peerAddress, true))
+		return 0;
+
+	_server.stats().relayed(ServerStats::ToPeer, size);
+	return _relaySocket./*base().*/send(data, size, peerAddress);
+}
+
+
+bool UDPAllocation::shape(const char* data, std::size_t size, const net::Address& address, bool toPeer)
+{
+	// Datagrams may not overtake those already queued
+	if (_queue.empty() && admit(size))
+		return true;
+
+	const ShapingOptions& options = shapingOptions();
+	if (options.policy != ShapingOptions::Queue) {
+		_server.stats().drop(ServerStats::RateLimited);
+		return false;
+	}
+	if (_queueSize + size > options.maxQueueSize) {
+		_server.stats().drop(ServerStats::QueueFull);
+		return false;
+	}
+
+	QueuedDatagram dgram;
+	dgram.data.assign(data, data + size);
+	dgram.address = address;
+	dgram.toPeer = toPeer;
+	_queue.push_back(std::move(dgram));
+	_queueSize += size;
+	if (!_queueTimer.active())
+		scheduleQueue();
+	return false;
+}
+
+
+void UDPAllocation::scheduleQueue()
+{
+	assert(!_queue.empty());
+	Int64 delay = static_cast<Int64>(admitDelay(_queue.front().data.size()));
+	_queueTimer.start(std::max<Int64>(delay, 1), 0);
+}
+
+
+void UDPAllocation::onQueueTimer(void*)
+{
+	while (!_queue.empty()) {
+		QueuedDatagram& dgram = _queue.front();
+		std::size_t size = dgram.data.size();
+		if (!admit(size)) {
+			scheduleQueue();
+			return;
+		}
+		if (dgram.toPeer) {
+			_server.stats().relayed(ServerStats::ToPeer, size);
+			_relaySocket.send(dgram.data.data(), size, dgram.address);
+		}
+		else
+			sendToClient(dgram.data.data(), size, dgram.address);
+		_queueSize -= size;
+		_queue.pop_front();
+	}
+}
+
+
+net::Address UDPAllocation::relayedAddress() const 
+{ 
+	//Mutex::ScopedLock lock(_mutex);
+	return _relaySocket.address();
+}
+
+
+} } //  namespace scy::turn
\ No newline at end of file
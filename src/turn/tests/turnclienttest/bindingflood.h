@@ -0,0 +1,110 @@
+#ifndef TURN_BindingFlood_TEST_H
+#define TURN_BindingFlood_TEST_H
+
+
+#include "turnclienttest.h"
+#include "scy/net/udpsocket.h"
+#include "scy/stun/message.h"
+#include "scy/logger.h"
+
+
+using namespace std;
+
+
+namespace scy {
+namespace turn {
+
+
+struct BindingFlood
+	/// Floods a STUN server with Binding requests over loopback UDP
+	/// and measures the response rate. A window of requests is kept 
+	/// in flight, and each response triggers the next request.
+{
+	net::UDPSocket socket;
+	net::Address serverAddr;
+	Buffer request;
+	int total;
+	int window;
+	int numSent;
+	int numReceived;
+	UInt64 started;
+	UInt64 elapsed;
+
+	BindingFlood(const net::Address& serverAddr, int total = 100000, int window = 256) : 
+		serverAddr(serverAddr),
+		total(total),
+		window(window),
+		numSent(0),
+		numReceived(0),
+		started(0),
+		elapsed(0)
+	{
+		stun::Message message(stun::Message::Request, stun::Message::Binding);
+		message.setTransactionID(util::randomString(stun::kTransactionIdLength));
+		message.write(request);
+
+		socket.Recv += sdelegate(this, &BindingFlood::onRecv);
+		socket.bind(net::Address("127.0.0.1", 0));
+	}
+
+	~BindingFlood()
+	{
+		socket.Recv -= sdelegate(this, &BindingFlood::onRecv);
+		socket.close();
+	}
+
+	void start()
+	{
+		DebugL << "Binding flood: Sending " << total << " requests to " << serverAddr << endl;
+		started = uv_hrtime();
+		for (int i = 0; i < window && numSent < total; i++)
+			send();
+	}
+
+	void send()
+	{
+		// Use the request count as the transaction ID
+		BitWriter writer(request.data(), request.size());
+		writer.updateU32(numSent++, stun::kTransactionIdOffset);
+		socket.send(request.data(), request.size(), serverAddr);
+	}
+
+	void onRecv(void*, const MutableBuffer& buffer, const net::Address&)
+	{
+		stun::Message response;
+		if (!response.read(constBuffer(bufferCast<const char*>(buffer), buffer.size())) ||
+			response.classType() != stun::Message::SuccessResponse) {
+			ErrorL << "Binding flood: Invalid response" << endl;
+			return;
+		}
+
+		if (++numReceived == total) {
+			elapsed = uv_hrtime() - started;
+			print(cout);
+			uv_stop(socket.loop());
+		}
+		else if (numSent < total)
+			send();
+	}
+
+	double requestsPerSecond() const
+	{
+		return elapsed ? numReceived / (elapsed / 1e9) : 0;
+	}
+
+	void print(ostream& ost) 
+	{	
+		ost << "Binding flood results:" 
+			<< "\n\tRequests: " << numSent
+			<< "\n\tResponses: " << numReceived
+			<< "\n\tElapsed: " << (elapsed / 1000000) << "ms"
+			<< "\n\tRate: " << requestsPerSecond() << " req/s"
+			<< endl;
+	}
+};
+
+
+} } //  namespace scy::turn
+
+
+#endif // TURN_BindingFlood_TEST_H
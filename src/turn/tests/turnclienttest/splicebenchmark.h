@@ -0,0 +1,182 @@
+#ifndef TURN_SpliceBenchmark_TEST_H
+#define TURN_SpliceBenchmark_TEST_H
+
+
+#include "turnclienttest.h"
+#include "scy/turn/server/splicerelay.h"
+#include "scy/thread.h"
+#include "scy/logger.h"
+
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+
+using namespace std;
+
+
+namespace scy {
+namespace turn {
+
+
+struct SpliceBenchmark
+	/// Measures TCP relay throughput over loopback, comparing a user 
+	/// space copy loop with the SpliceRelay used for bound TURN TCP 
+	/// connection pairs. A writer thread sends data to the relay
+	/// and a reader thread drains it on the other side.
+{
+	UInt64 total;
+	UInt64 relayed;
+	UInt64 started;
+	UInt64 elapsed;
+
+	SpliceBenchmark(UInt64 total = 512 * 1024 * 1024) : 
+		total(total),
+		relayed(0),
+		started(0),
+		elapsed(0)
+	{
+	}
+
+	void run()
+	{
+		double copy = runCopy();
+		double splice = runSplice();
+		cout << "Splice benchmark results:" 
+			<< "\n\tBytes: " << total
+			<< "\n\tUser space copy: " << copy << " MB/s"
+			<< "\n\tSplice: " << splice << " MB/s"
+			<< endl;
+	}
+
+	double runCopy()
+	{
+		int in, out;
+		Thread* writer; 
+		Thread* reader;
+		start(in, out, writer, reader);
+
+		// Relay with a blocking read and write loop
+		std::vector<char> buf(64 * 1024);
+		UInt64 count = 0;
+		while (count < total) {
+			ssize_t n = ::read(in, buf.data(), buf.size());
+			if (n <= 0)
+				break;
+			for (ssize_t sent = 0; sent < n;) {
+				ssize_t r = ::write(out, buf.data() + sent, n - sent);
+				if (r <= 0)
+					break;
+				sent += r;
+			}
+			count += n;
+		}
+		elapsed = uv_hrtime() - started;
+		finish(in, out, writer, reader);
+		return rate();
+	}
+
+	double runSplice()
+	{
+		int in, out;
+		Thread* writer; 
+		Thread* reader;
+		start(in, out, writer, reader);
+		fcntl(in, F_SETFL, O_NONBLOCK);
+		fcntl(out, F_SETFL, O_NONBLOCK);
+
+		relayed = 0;
+		SpliceRelay relay(in, out);
+		relay.Relayed = [&](SpliceRelay::Direction, std::size_t size) {
+			if ((relayed += size) >= total) {
+				elapsed = uv_hrtime() - started;
+				uv_stop(uv::defaultLoop());
+			}
+			return true;
+		};
+		relay.Closed = [&]() {
+			uv_stop(uv::defaultLoop());
+		};
+		if (!relay.start()) {
+			ErrorL << "Splice benchmark: splice is not supported" << endl;
+			finish(in, out, writer, reader);
+			return 0;
+		}
+
+		uv_run(uv::defaultLoop(), UV_RUN_DEFAULT);
+		relay.stop();
+		finish(in, out, writer, reader);
+		return rate();
+	}
+
+	double rate() const
+	{
+		return elapsed ? (total / (1024.0 * 1024.0)) / (elapsed / 1e9) : 0;
+	}
+
+	void start(int& in, int& out, Thread*& writer, Thread*& reader)
+		// Connects the writer to the relay input, and the relay 
+		// output to the reader, then starts both threads.
+	{
+		int src, dst;
+		connectPair(src, in);
+		connectPair(out, dst);
+		UInt64 size = total;
+		started = uv_hrtime();
+		writer = new Thread([src, size]() {
+			std::vector<char> buf(64 * 1024, 'x');
+			for (UInt64 sent = 0; sent < size;) {
+				ssize_t n = ::write(src, buf.data(), std::min<UInt64>(buf.size(), size - sent));
+				if (n <= 0)
+					break;
+				sent += n;
+			}
+			::shutdown(src, SHUT_WR);
+		});
+		reader = new Thread([dst, size]() {
+			std::vector<char> buf(64 * 1024);
+			for (UInt64 received = 0; received < size;) {
+				ssize_t n = ::read(dst, buf.data(), buf.size());
+				if (n <= 0)
+					break;
+				received += n;
+			}
+		});
+	}
+
+	void finish(int in, int out, Thread* writer, Thread* reader)
+	{
+		writer->join();
+		reader->join();
+		delete writer;
+		delete reader;
+		::close(in);
+		::close(out);
+	}
+
+	static void connectPair(int& a, int& b)
+		// Creates a connected pair of loopback TCP sockets.
+	{
+		int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+		sockaddr_in addr;
+		socklen_t len = sizeof(addr);
+		memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		::bind(listener, (sockaddr*)&addr, sizeof(addr));
+		::listen(listener, 1);
+		::getsockname(listener, (sockaddr*)&addr, &len);
+		a = ::socket(AF_INET, SOCK_STREAM, 0);
+		::connect(a, (sockaddr*)&addr, sizeof(addr));
+		b = ::accept(listener, nullptr, nullptr);
+		::close(listener);
+	}
+};
+
+
+} } //  namespace scy::turn
+
+
+#endif // TURN_SpliceBenchmark_TEST_H
@@ -0,0 +1,209 @@
+#include "scy/base.h"
+#include "scy/application.h"
+#include "scy/platform.h"
+#include "scy/logger.h"
+#include "scy/turn/server/credentialcache.h"
+#include "scy/turn/server/rateshaper.h"
+
+#include <assert.h>
+
+
+using namespace std;
+using namespace scy;
+
+
+namespace scy {
+namespace turn {
+
+
+class Tests
+{
+public:
+	Application app;
+
+	Tests()
+	{
+		testCredentialCache();
+		testTokenBucket();
+		testRateShaper();
+	}
+
+	~Tests()
+	{
+		app.finalize();
+	}
+
+	// ============================================================================
+	// Credential Cache Test
+	//
+	void testCredentialCache()
+	{
+		CredentialCache cache(app.loop, 2, 20);
+		std::string key;
+
+		// Unknown users miss
+		bool found = cache.find("alice", "realm", "n1", key);
+		assert(!found);
+		assert(cache.stats().misses == 1);
+
+		// Requests with the cached nonce hit
+		cache.store("alice", "realm", "n1", "alicekey");
+		found = cache.find("alice", "realm", "n1", key);
+		assert(found);
+		assert(key == "alicekey");
+		assert(cache.stats().hits == 1);
+
+		// A new nonce misses without dropping the entry
+		key.clear();
+		found = cache.find("alice", "realm", "n2", key);
+		assert(!found);
+		assert(key.empty());
+		assert(cache.size() == 1);
+		assert(cache.stats().misses == 2);
+
+		// The least recently used entry is evicted
+		cache.store("bob", "realm", "n1", "bobkey");
+		found = cache.find("alice", "realm", "n1", key);
+		assert(found);
+		cache.store("carol", "realm", "n1", "carolkey");
+		assert(cache.size() == 2);
+		assert(cache.stats().evicted == 1);
+		found = cache.find("bob", "realm", "n1", key);
+		assert(!found);
+		found = cache.find("carol", "realm", "n1", key);
+		assert(found);
+		assert(key == "carolkey");
+		assert(cache.stats().hits == 3);
+		assert(cache.stats().misses == 3);
+		assert(cache.stats().hitRate() == 0.5);
+
+		// Entries expire after their lifetime and are dropped on access
+		scy::sleep(30);
+		uv_update_time(app.loop);
+		found = cache.find("alice", "realm", "n1", key);
+		assert(!found);
+		assert(cache.size() == 1);
+
+		// Storing again refreshes the lifetime
+		cache.store("carol", "realm", "n3", "carolkey2");
+		found = cache.find("carol", "realm", "n3", key);
+		assert(found);
+		assert(key == "carolkey2");
+
+		// Invalidated entries miss
+		cache.invalidate("carol", "realm");
+		found = cache.find("carol", "realm", "n3", key);
+		assert(!found);
+		assert(cache.size() == 0);
+
+		// A zero limit disables caching
+		cache.store("alice", "realm", "n1", "alicekey");
+		cache.setLimit(0);
+		assert(cache.size() == 0);
+		cache.store("alice", "realm", "n1", "alicekey");
+		assert(cache.size() == 0);
+	}
+
+	// ============================================================================
+	// Token Bucket Test
+	//
+	void testTokenBucket()
+	{
+		// Disabled buckets admit everything
+		TokenBucket none;
+		assert(!none.enabled());
+		bool ok = none.available(1000000, 0);
+		assert(ok);
+		assert(none.delay(1000000) == 0);
+
+		// Buckets start full, holding one second of tokens by default
+		TokenBucket bucket(1000, 0, 0);
+		assert(bucket.enabled());
+		ok = bucket.available(1000, 0);
+		assert(ok);
+
+		// Oversized reads are admitted once the bucket is full
+		ok = bucket.available(5000, 0);
+		assert(ok);
+
+		bucket.consume(1000);
+		ok = bucket.available(1, 0);
+		assert(!ok);
+		assert(bucket.delay(1) == 1);
+
+		// Tokens accrue with the clock
+		ok = bucket.available(500, 500);
+		assert(ok);
+		ok = bucket.available(501, 500);
+		assert(!ok);
+		assert(bucket.delay(501) == 1);
+
+		// Refills are capped at the burst size
+		ok = bucket.available(1000, 10000);
+		assert(ok);
+		bucket.consume(1000);
+		ok = bucket.available(1, 10000);
+		assert(!ok);
+
+		// Unconditional consumption goes into debt, which 
+		// must be repaid before anything is admitted
+		bucket.consume(500);
+		assert(bucket.delay(1) == 501);
+		ok = bucket.available(1, 10500);
+		assert(!ok);
+		ok = bucket.available(1, 10501);
+		assert(ok);
+
+		// Fractional tokens are carried between refills
+		TokenBucket slow(3, 1, 0);
+		slow.consume(1);
+		ok = slow.available(1, 333);
+		assert(!ok);
+		assert(slow.delay(1) == 1);
+		ok = slow.available(1, 334);
+		assert(ok);
+	}
+
+	// ============================================================================
+	// Rate Shaper Test
+	//
+	void testRateShaper()
+	{
+		ShapingOptions options;
+		options.bytesPerSecond = 1000;
+		options.packetsPerSecond = 2;
+		assert(options.enabled());
+
+		// Both the byte and packet limits must allow the data
+		RateShaper shaper(options, 0);
+		bool ok = shaper.admit(100, 0);
+		assert(ok);
+		ok = shaper.admit(100, 0);
+		assert(ok);
+		ok = shaper.admit(100, 0);
+		assert(!ok);
+		assert(shaper.delay(100) == 500);
+		ok = shaper.admit(100, 500);
+		assert(ok);
+
+		// Rejected data leaves the buckets alone
+		ok = shaper.admit(2000, 500);
+		assert(!ok);
+		ok = shaper.admit(1, 1000);
+		assert(ok);
+	}
+};
+
+
+} } // namespace scy::turn
+
+
+int main(int argc, char** argv)
+{
+	Logger::instance().add(new ConsoleChannel("debug", LTrace));
+	{
+		turn::Tests run;
+	}
+	Logger::destroy();
+	return 0;
+}